@@ -0,0 +1,196 @@
+#include "cidr.h"
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <algorithm>
+#include <cstring>
+
+static int addr_bytes(int family) {
+    return family == AF_INET ? 4 : 16;
+}
+
+// 按前缀长度清零主机位
+static void mask_host_bits(uint8_t* addr, int nbytes, int prefix_len) {
+    for (int i = 0; i < nbytes; i++) {
+        int bits = prefix_len - i * 8;
+        if (bits >= 8) continue;
+        addr[i] &= (bits <= 0) ? 0 : static_cast<uint8_t>(0xFF << (8 - bits));
+    }
+}
+
+// 比较两个地址的前bits位是否相同
+static bool prefix_equal(const uint8_t* a, const uint8_t* b, int bits) {
+    int full = bits / 8;
+    if (memcmp(a, b, full) != 0) {
+        return false;
+    }
+    int rest = bits % 8;
+    if (rest == 0) {
+        return true;
+    }
+    uint8_t m = static_cast<uint8_t>(0xFF << (8 - rest));
+    return (a[full] & m) == (b[full] & m);
+}
+
+// CIDR解析函数
+bool parse_cidr(const char* cidr, size_t len, cidr_prefix& out, bool strict) {
+    if (cidr == nullptr) {
+        return false;
+    }
+
+    // 单次扫描定位'/'并判断地址族
+    size_t slash = len;
+    bool has_colon = false;
+    for (size_t i = 0; i < len; i++) {
+        char c = cidr[i];
+        if (c == '/') {
+            slash = i;
+            break;
+        }
+        if (c == ':') has_colon = true;
+    }
+    if (slash == len || slash == 0 || slash >= INET6_ADDRSTRLEN) {
+        return false;
+    }
+    // inet_pton读到NUL即停止，地址部分内嵌NUL（如"10.0.0.1\0junk/24"）会被截断后接受
+    if (memchr(cidr, '\0', slash) != nullptr) {
+        return false;
+    }
+
+    // 前缀长度：1-3位数字，不允许前导零
+    const char* p = cidr + slash + 1;
+    size_t plen = len - slash - 1;
+    if (plen == 0 || plen > 3 || (plen > 1 && p[0] == '0')) {
+        return false;
+    }
+    int prefix_len = 0;
+    for (size_t i = 0; i < plen; i++) {
+        if (p[i] < '0' || p[i] > '9') {
+            return false;
+        }
+        prefix_len = prefix_len * 10 + (p[i] - '0');
+    }
+
+    int family = has_colon ? AF_INET6 : AF_INET;
+    int nbytes = addr_bytes(family);
+    if (prefix_len > nbytes * 8) {
+        return false;
+    }
+
+    // inet_pton需要以NUL结尾的地址串，复制到栈上缓冲区
+    char buf[INET6_ADDRSTRLEN];
+    memcpy(buf, cidr, slash);
+    buf[slash] = '\0';
+
+    uint8_t addr[16] = {0};
+    if (inet_pton(family, buf, addr) != 1) {
+        return false;
+    }
+
+    uint8_t network[16];
+    memcpy(network, addr, sizeof(addr));
+    mask_host_bits(network, nbytes, prefix_len);
+    if (strict && memcmp(network, addr, nbytes) != 0) {
+        return false;
+    }
+
+    out.family = family;
+    memcpy(out.addr, network, sizeof(network));
+    out.prefix_len = prefix_len;
+    return true;
+}
+
+bool parse_cidr(const std::string& cidr, cidr_prefix& out, bool strict) {
+    return parse_cidr(cidr.data(), cidr.size(), out, strict);
+}
+
+// CIDR验证函数
+bool validate_cidr(const std::string& cidr) {
+    cidr_prefix prefix;
+    return parse_cidr(cidr, prefix);
+}
+
+bool cidr_contains(const cidr_prefix& a, const cidr_prefix& b) {
+    if (a.family != b.family || a.prefix_len > b.prefix_len) {
+        return false;
+    }
+    return prefix_equal(a.addr, b.addr, a.prefix_len);
+}
+
+bool cidr_overlaps(const cidr_prefix& a, const cidr_prefix& b) {
+    return cidr_contains(a, b) || cidr_contains(b, a);
+}
+
+// 批量重叠检测
+std::vector<cidr_overlap> find_cidr_overlaps(const std::vector<cidr_prefix>& prefixes) {
+    // 按(地址族, 网络地址, 前缀长度, 下标)排序：包含者总排在被包含者之前
+    std::vector<size_t> order(prefixes.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&prefixes](size_t x, size_t y) {
+        const cidr_prefix& a = prefixes[x];
+        const cidr_prefix& b = prefixes[y];
+        if (a.family != b.family) return a.family < b.family;
+        int c = memcmp(a.addr, b.addr, sizeof(a.addr));
+        if (c != 0) return c < 0;
+        if (a.prefix_len != b.prefix_len) return a.prefix_len < b.prefix_len;
+        return x < y;
+    });
+
+    // 扫描时维护当前嵌套链：栈内每个前缀都包含其上方的前缀
+    std::vector<cidr_overlap> result;
+    std::vector<size_t> stack;
+    for (size_t idx : order) {
+        const cidr_prefix& cur = prefixes[idx];
+        while (!stack.empty() && !cidr_contains(prefixes[stack.back()], cur)) {
+            stack.pop_back();
+        }
+        if (!stack.empty()) {
+            result.push_back({stack.back(), idx});
+        }
+        stack.push_back(idx);
+    }
+    return result;
+}
+
+cidr_set::key_type cidr_set::make_key(const cidr_prefix& prefix) {
+    key_type key;
+    key.first = prefix.family;
+    memcpy(key.second.data(), prefix.addr, sizeof(prefix.addr));
+    return key;
+}
+
+bool cidr_set::find_overlap(const cidr_prefix& prefix, cidr_prefix* conflict) const {
+    key_type key = make_key(prefix);
+
+    // 集合内前缀互不相交：只需检查起始地址不大于prefix的最后一个前缀（可能包含prefix），
+    // 以及起始地址不小于prefix的第一个前缀（可能被prefix包含）
+    auto it = entries_.lower_bound(key);
+    if (it != entries_.end() && cidr_overlaps(it->second, prefix)) {
+        if (conflict) *conflict = it->second;
+        return true;
+    }
+    if (it != entries_.begin()) {
+        --it;
+        if (cidr_overlaps(it->second, prefix)) {
+            if (conflict) *conflict = it->second;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool cidr_set::insert(const cidr_prefix& prefix, cidr_prefix* conflict) {
+    if (find_overlap(prefix, conflict)) {
+        return false;
+    }
+    entries_.emplace(make_key(prefix), prefix);
+    return true;
+}
+
+bool cidr_set::erase(const cidr_prefix& prefix) {
+    auto it = entries_.find(make_key(prefix));
+    if (it == entries_.end() || it->second.prefix_len != prefix.prefix_len) {
+        return false;
+    }
+    entries_.erase(it);
+    return true;
+}
@@ -0,0 +1,69 @@
+#ifndef CIDR_H
+#define CIDR_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <array>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+// CIDR前缀（网络地址 + 前缀长度）
+struct cidr_prefix {
+    int family;             // AF_INET 或 AF_INET6
+    uint8_t addr[16];       // 网络地址（网络字节序，主机位已清零），IPv4只使用前4字节
+    int prefix_len;         // 前缀长度：IPv4为0-32，IPv6为0-128
+};
+
+// CIDR解析函数
+// 一次扫描解析 a.b.c.d/nn 或 IPv6/nn，输出网络地址和前缀长度
+// strict为true时要求主机位全为0（如 10.0.0.1/8 视为无效）
+bool parse_cidr(const char* cidr, size_t len, cidr_prefix& out, bool strict = false);
+bool parse_cidr(const std::string& cidr, cidr_prefix& out, bool strict = false);
+
+// CIDR验证函数
+bool validate_cidr(const std::string& cidr);
+
+// 判断a是否包含b（相等也视为包含），不同地址族互不包含
+bool cidr_contains(const cidr_prefix& a, const cidr_prefix& b);
+
+// 判断两个前缀是否重叠（CIDR块要么不相交，要么一方包含另一方）
+bool cidr_overlaps(const cidr_prefix& a, const cidr_prefix& b);
+
+// 重叠记录：prefixes[inner]被prefixes[outer]包含
+struct cidr_overlap {
+    size_t outer;
+    size_t inner;
+};
+
+// 批量重叠检测
+// 排序后单次扫描，O(n log n)。每个被包含的前缀只报告一次，outer为包含它的最小前缀；
+// 完全相同的前缀按下标顺序报告为后者被前者包含
+std::vector<cidr_overlap> find_cidr_overlaps(const std::vector<cidr_prefix>& prefixes);
+
+// 互不重叠的子网集合
+// 用于逐条登记子网分配：插入与已有子网重叠的前缀会被拒绝，单次插入O(log n)
+class cidr_set {
+public:
+    // 插入前缀；若与已有前缀重叠则返回false，并在conflict非空时写入冲突前缀
+    bool insert(const cidr_prefix& prefix, cidr_prefix* conflict = nullptr);
+
+    // 删除完全相同的前缀
+    bool erase(const cidr_prefix& prefix);
+
+    // 查找与prefix重叠的已有前缀
+    bool find_overlap(const cidr_prefix& prefix, cidr_prefix* conflict = nullptr) const;
+
+    size_t size() const { return entries_.size(); }
+    void clear() { entries_.clear(); }
+
+private:
+    // 以(地址族, 网络地址)为键；集合内前缀互不重叠，因此起始地址唯一
+    typedef std::pair<int, std::array<uint8_t, 16> > key_type;
+    static key_type make_key(const cidr_prefix& prefix);
+
+    std::map<key_type, cidr_prefix> entries_;
+};
+
+#endif // CIDR_H
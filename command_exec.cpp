@@ -0,0 +1,305 @@
+#include "command_exec.h"
+#include <spawn.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <cerrno>
+
+extern char** environ;
+
+// 待读取的捕获管道
+struct capture_fd {
+    int fd;
+    std::string* dest;
+};
+
+static void close_fd(int& fd) {
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+}
+
+static void init_result(exec_result& res) {
+    res.exit_status = -1;
+    res.term_signal = 0;
+    res.spawn_errno = 0;
+    res.out.clear();
+    res.err.clear();
+}
+
+// 构造以nullptr结尾的argv，拒绝空命令和含NUL的参数
+static bool build_argv(const std::vector<std::string>& argv, std::vector<char*>& cargv) {
+    if (argv.empty() || argv[0].empty()) {
+        return false;
+    }
+    cargv.clear();
+    cargv.reserve(argv.size() + 1);
+    for (const std::string& arg : argv) {
+        if (arg.find('\0') != std::string::npos) {
+            return false;
+        }
+        cargv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    cargv.push_back(nullptr);
+    return true;
+}
+
+// 启动单个进程，in/out/err_fd为-1表示继承父进程
+// 成功返回0，失败返回errno
+static int spawn_one(const std::vector<std::string>& argv,
+                     int in_fd, int out_fd, int err_fd, pid_t& pid) {
+    std::vector<char*> cargv;
+    if (!build_argv(argv, cargv)) {
+        return EINVAL;
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawnattr_t attr;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawnattr_init(&attr);
+
+    if (in_fd >= 0) posix_spawn_file_actions_adddup2(&actions, in_fd, STDIN_FILENO);
+    if (out_fd >= 0) posix_spawn_file_actions_adddup2(&actions, out_fd, STDOUT_FILENO);
+    if (err_fd >= 0) posix_spawn_file_actions_adddup2(&actions, err_fd, STDERR_FILENO);
+
+    // 子进程使用空信号屏蔽字，并恢复SIGPIPE默认处理（管道下游退出时上游应终止）
+    sigset_t empty_mask, default_sigs;
+    sigemptyset(&empty_mask);
+    sigemptyset(&default_sigs);
+    sigaddset(&default_sigs, SIGPIPE);
+    posix_spawnattr_setsigmask(&attr, &empty_mask);
+    posix_spawnattr_setsigdefault(&attr, &default_sigs);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF);
+
+    int rc;
+    if (argv[0].find('/') != std::string::npos) {
+        rc = posix_spawn(&pid, cargv[0], &actions, &attr, cargv.data(), environ);
+    } else {
+        rc = posix_spawnp(&pid, cargv[0], &actions, &attr, cargv.data(), environ);
+    }
+
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&actions);
+    return rc;
+}
+
+// 创建close-on-exec管道，避免管道端泄漏到其他子进程
+static bool make_pipe(int fds[2]) {
+    if (pipe2(fds, O_CLOEXEC) != 0) {
+        fds[0] = fds[1] = -1;
+        return false;
+    }
+    return true;
+}
+
+// 读取所有捕获管道直到EOF，读完后关闭
+static void drain_captures(std::vector<capture_fd>& caps) {
+    std::vector<pollfd> pfds;
+    std::vector<size_t> index;
+    char buf[65536];
+
+    for (;;) {
+        pfds.clear();
+        index.clear();
+        for (size_t i = 0; i < caps.size(); i++) {
+            if (caps[i].fd >= 0) {
+                pfds.push_back({caps[i].fd, POLLIN, 0});
+                index.push_back(i);
+            }
+        }
+        if (pfds.empty()) {
+            break;
+        }
+
+        if (poll(pfds.data(), pfds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+
+        for (size_t k = 0; k < pfds.size(); k++) {
+            if (pfds[k].revents == 0) continue;
+            capture_fd& cap = caps[index[k]];
+            ssize_t n = read(cap.fd, buf, sizeof(buf));
+            if (n > 0) {
+                cap.dest->append(buf, static_cast<size_t>(n));
+            } else if (n == 0 || (errno != EINTR && errno != EAGAIN)) {
+                close_fd(cap.fd);
+            }
+        }
+    }
+
+    for (capture_fd& cap : caps) {
+        close_fd(cap.fd);
+    }
+}
+
+// 回收子进程并填写退出状态
+static void wait_child(pid_t pid, exec_result& res) {
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) {
+            res.exit_status = -1;
+            return;
+        }
+    }
+    if (WIFEXITED(status)) {
+        res.exit_status = WEXITSTATUS(status);
+        res.term_signal = 0;
+    } else if (WIFSIGNALED(status)) {
+        res.exit_status = -1;
+        res.term_signal = WTERMSIG(status);
+    }
+}
+
+// 启动一条命令，按flags建立捕获管道并登记到caps
+static bool launch(const std::vector<std::string>& argv, int flags,
+                   exec_result& res, std::vector<capture_fd>& caps, pid_t& pid) {
+    int out_pipe[2] = {-1, -1};
+    int err_pipe[2] = {-1, -1};
+
+    if (((flags & EXEC_CAPTURE_STDOUT) && !make_pipe(out_pipe)) ||
+        ((flags & EXEC_CAPTURE_STDERR) && !make_pipe(err_pipe))) {
+        res.spawn_errno = errno;
+        close_fd(out_pipe[0]); close_fd(out_pipe[1]);
+        close_fd(err_pipe[0]); close_fd(err_pipe[1]);
+        return false;
+    }
+
+    int rc = spawn_one(argv, -1, out_pipe[1], err_pipe[1], pid);
+
+    // 父进程不需要写端
+    close_fd(out_pipe[1]);
+    close_fd(err_pipe[1]);
+
+    if (rc != 0) {
+        res.spawn_errno = rc;
+        close_fd(out_pipe[0]);
+        close_fd(err_pipe[0]);
+        return false;
+    }
+
+    if (out_pipe[0] >= 0) caps.push_back({out_pipe[0], &res.out});
+    if (err_pipe[0] >= 0) caps.push_back({err_pipe[0], &res.err});
+    return true;
+}
+
+// 执行单条命令
+int exec_command(const std::vector<std::string>& argv, exec_result& res, int flags) {
+    init_result(res);
+
+    std::vector<capture_fd> caps;
+    pid_t pid = -1;
+    if (!launch(argv, flags, res, caps, pid)) {
+        return -1;
+    }
+
+    drain_captures(caps);
+    wait_child(pid, res);
+    return 0;
+}
+
+// 批量执行命令
+int exec_commands(const std::vector<std::vector<std::string>>& cmds,
+                  std::vector<exec_result>& results, int flags) {
+    results.resize(cmds.size());
+
+    std::vector<capture_fd> caps;
+    std::vector<pid_t> pids(cmds.size(), -1);
+    int started = 0;
+
+    // 先全部启动，使各命令并发运行
+    for (size_t i = 0; i < cmds.size(); i++) {
+        init_result(results[i]);
+        if (launch(cmds[i], flags, results[i], caps, pids[i])) {
+            started++;
+        } else {
+            pids[i] = -1;
+        }
+    }
+
+    drain_captures(caps);
+
+    for (size_t i = 0; i < cmds.size(); i++) {
+        if (pids[i] > 0) {
+            wait_child(pids[i], results[i]);
+        }
+    }
+    return started;
+}
+
+// 管道执行
+int exec_pipeline(const std::vector<std::vector<std::string>>& stages,
+                  exec_result& res, int flags) {
+    init_result(res);
+    if (stages.empty()) {
+        res.spawn_errno = EINVAL;
+        return -1;
+    }
+
+    int out_pipe[2] = {-1, -1};
+    int err_pipe[2] = {-1, -1};
+    if (((flags & EXEC_CAPTURE_STDOUT) && !make_pipe(out_pipe)) ||
+        ((flags & EXEC_CAPTURE_STDERR) && !make_pipe(err_pipe))) {
+        res.spawn_errno = errno;
+        close_fd(out_pipe[0]); close_fd(out_pipe[1]);
+        close_fd(err_pipe[0]); close_fd(err_pipe[1]);
+        return -1;
+    }
+
+    std::vector<pid_t> pids;
+    pids.reserve(stages.size());
+    int prev_read = -1;     // 上一级输出管道的读端，作为本级标准输入
+    int rc = 0;
+
+    for (size_t i = 0; i < stages.size(); i++) {
+        bool last = (i + 1 == stages.size());
+        int link[2] = {-1, -1};
+        if (!last && !make_pipe(link)) {
+            rc = errno;
+            break;
+        }
+
+        pid_t pid = -1;
+        int stage_out = last ? out_pipe[1] : link[1];
+        rc = spawn_one(stages[i], prev_read, stage_out, err_pipe[1], pid);
+
+        close_fd(prev_read);
+        close_fd(link[1]);
+        prev_read = link[0];
+
+        if (rc != 0) {
+            break;
+        }
+        pids.push_back(pid);
+    }
+
+    close_fd(prev_read);
+    close_fd(out_pipe[1]);
+    close_fd(err_pipe[1]);
+
+    std::vector<capture_fd> caps;
+    if (out_pipe[0] >= 0) caps.push_back({out_pipe[0], &res.out});
+    if (err_pipe[0] >= 0) caps.push_back({err_pipe[0], &res.err});
+    drain_captures(caps);
+
+    // 回收所有已启动的进程，最后一级的状态作为整体结果
+    exec_result stage_res;
+    for (size_t i = 0; i < pids.size(); i++) {
+        init_result(stage_res);
+        wait_child(pids[i], stage_res);
+        if (rc == 0 && i + 1 == stages.size()) {
+            res.exit_status = stage_res.exit_status;
+            res.term_signal = stage_res.term_signal;
+        }
+    }
+
+    if (rc != 0) {
+        res.spawn_errno = rc;
+        return -1;
+    }
+    return 0;
+}
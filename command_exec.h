@@ -0,0 +1,47 @@
+#ifndef COMMAND_EXEC_H
+#define COMMAND_EXEC_H
+
+#include <string>
+#include <vector>
+
+// 命令执行接口
+// 直接通过posix_spawn启动argv（glibc下为vfork语义），绝不经过/bin/sh，
+// 因此参数无需shell_quote转义。调用方应先用validate_interface_name、
+// validate_ipv4等函数校验各参数。
+
+// 捕获标志
+enum exec_flags {
+    EXEC_CAPTURE_NONE   = 0,
+    EXEC_CAPTURE_STDOUT = 1 << 0,   // 捕获标准输出到exec_result::out
+    EXEC_CAPTURE_STDERR = 1 << 1,   // 捕获标准错误到exec_result::err
+};
+
+// 执行结果
+struct exec_result {
+    int exit_status;    // 进程退出码，启动失败或被信号终止时为-1
+    int term_signal;    // 终止信号，正常退出时为0
+    int spawn_errno;    // posix_spawn失败时的errno，成功为0
+    std::string out;    // 捕获的标准输出
+    std::string err;    // 捕获的标准错误
+};
+
+// 执行单条命令并等待结束
+// argv[0]含'/'时按路径执行，否则在PATH中查找
+// 返回0表示进程已启动并被回收（退出码见res.exit_status），-1表示启动失败
+int exec_command(const std::vector<std::string>& argv, exec_result& res,
+                 int flags = EXEC_CAPTURE_NONE);
+
+// 批量执行多条相互独立的命令
+// 先全部启动再统一收集输出和回收，results与cmds一一对应
+// 返回成功启动的命令数
+int exec_commands(const std::vector<std::vector<std::string>>& cmds,
+                  std::vector<exec_result>& results,
+                  int flags = EXEC_CAPTURE_NONE);
+
+// 管道执行：stages[0] | stages[1] | ... | stages[n-1]
+// EXEC_CAPTURE_STDOUT捕获最后一级的输出，EXEC_CAPTURE_STDERR捕获所有级的错误输出
+// res.exit_status为最后一级的退出码；任何一级启动失败返回-1
+int exec_pipeline(const std::vector<std::vector<std::string>>& stages,
+                  exec_result& res, int flags = EXEC_CAPTURE_NONE);
+
+#endif // COMMAND_EXEC_H
@@ -0,0 +1,63 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "command_exec.h"
+#include "input_validation.h"
+
+using namespace std;
+
+static int g_passed = 0;
+static int g_total = 0;
+
+static void check(const string& name, bool ok) {
+    g_total++;
+    cout << "测试: " << name << " ";
+    if (ok) {
+        cout << "✓ 通过" << endl;
+        g_passed++;
+    } else {
+        cout << "✗ 失败" << endl;
+    }
+}
+
+int main() {
+    cout << "=== command_exec 测试 ===" << endl;
+
+    exec_result res;
+
+    // 参数原样传递，不经过shell解释
+    string ip = "127.0.0.1";
+    int rc = exec_command({"/bin/echo", ip, "a b", "$(whoami);'"}, res, EXEC_CAPTURE_STDOUT);
+    check("echo 原样输出", validate_ipv4(ip) && rc == 0 && res.exit_status == 0 &&
+                          res.out == "127.0.0.1 a b $(whoami);'\n");
+
+    rc = exec_command({"false"}, res);
+    check("PATH查找与退出码", rc == 0 && res.exit_status == 1);
+
+    rc = exec_command({"/nonexistent/binary"}, res);
+    check("启动失败", rc == -1 && res.spawn_errno != 0);
+
+    rc = exec_command({}, res);
+    check("空argv", rc == -1);
+
+    rc = exec_command({"ls", "/nonexistent-dir-for-test"}, res, EXEC_CAPTURE_STDERR);
+    check("捕获stderr", rc == 0 && res.exit_status != 0 && !res.err.empty() && res.out.empty());
+
+    vector<exec_result> results;
+    int started = exec_commands({{"/bin/echo", "one"}, {"/nonexistent"}, {"/bin/echo", "three"}},
+                                results, EXEC_CAPTURE_STDOUT);
+    check("批量执行", started == 2 && results.size() == 3 &&
+                     results[0].out == "one\n" && results[1].spawn_errno != 0 &&
+                     results[2].out == "three\n");
+
+    rc = exec_pipeline({{"/bin/echo", "eth0 up"}, {"tr", "a-z", "A-Z"}, {"tr", "-d", " "}},
+                       res, EXEC_CAPTURE_STDOUT);
+    check("管道执行", rc == 0 && res.exit_status == 0 && res.out == "ETH0UP\n");
+
+    rc = exec_pipeline({{"/bin/echo", "x"}, {"/nonexistent"}}, res, EXEC_CAPTURE_STDOUT);
+    check("管道启动失败", rc == -1);
+
+    cout << "\n测试结果: " << g_passed << "/" << g_total << " 通过" << endl;
+    return g_passed == g_total ? 0 : 1;
+}
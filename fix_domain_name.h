@@ -1,61 +1,50 @@
-
 #include <string>
+#include <string_view>
+#include <memory_resource>
 #include <cctype>
 using namespace std;
 
-string fix_domain_name(const string& s) {
-    if (s.empty()) {
-        return "";
-    }
-    
-    string result;
-    result.reserve(s.length()); // 预分配空间提高效率
+// 域名修正的核心逻辑：单次扫描写入out（out需为空）
+// 只保留字母、数字和连接符，去掉开头/结尾及连续的连接符，最长63个字符
+template <typename Str>
+void fix_domain_name_into(string_view s, Str& out) {
+    out.reserve(s.length() < 63 ? s.length() : 63); // 预分配空间提高效率
     
     for (char c : s) {
-        // 只保留字母、数字和连接符
-        if (isalnum(c) || c == '-') {
-            result += c;
-        }
-        // 其他字符直接丢弃
-    }
-    
-    if (result.empty()) {
-        return "";
-    }
-    
-    // 处理连接符规则
-    string fixed;
-    fixed.reserve(result.length());
-    
-    char prev = '\0';
-    for (char c : result) {
-        // 跳过开头的连接符
-        if (fixed.empty() && c == '-') {
+        // 只保留字母、数字和连接符，其他字符直接丢弃
+        if (!isalnum(static_cast<unsigned char>(c)) && c != '-') {
             continue;
         }
         
-        // 跳过连续的连接符
-        if (c == '-' && prev == '-') {
-            continue;
+        if (c == '-') {
+            // 跳过开头的连接符和连续的连接符
+            if (out.empty() || out.back() == '-') {
+                continue;
+            }
         }
         
-        fixed += c;
-        prev = c;
+        // 限制长度为63个字符
+        if (out.length() == 63) {
+            break;
+        }
+        out += c;
     }
     
     // 去掉结尾的连接符
-    while (!fixed.empty() && fixed.back() == '-') {
-        fixed.pop_back();
-    }
-    
-    // 限制长度为63个字符
-    if (fixed.length() > 63) {
-        fixed = fixed.substr(0, 63);
-        // 再次检查结尾是否有连接符
-        while (!fixed.empty() && fixed.back() == '-') {
-            fixed.pop_back();
-        }
+    while (!out.empty() && out.back() == '-') {
+        out.pop_back();
     }
-    
+}
+
+string fix_domain_name(const string& s) {
+    string fixed;
+    fix_domain_name_into(s, fixed);
+    return fixed;
+}
+
+// pmr版本：结果从mr分配
+inline pmr::string fix_domain_name(string_view s, pmr::memory_resource* mr) {
+    pmr::string fixed(mr);
+    fix_domain_name_into(s, fixed);
     return fixed;
 }
@@ -0,0 +1,314 @@
+#ifndef HOST_POLICY_H
+#define HOST_POLICY_H
+
+#include <string_view>
+#include <cstddef>
+#include <arpa/inet.h>
+#include "host_validator.h"
+#include "validation_metrics.h"
+
+// ===========================================
+// 按策略定制的主机地址校验
+// 策略类型用constexpr成员描述各项规则，HostValidator<Policy>在编译期按策略展开，
+// 不同服务各自实例化需要的变体，运行时没有额外分支。
+// is_valid_host()/classify_host()是default_host_policy的实例化。
+// ===========================================
+
+// 默认规则（与is_valid_host一致）
+struct default_host_policy {
+    // 域名标签允许'_'（SRV记录等，如 _sip._tcp.example.com）
+    static constexpr bool allow_underscore = false;
+    // 域名允许一个表示根的结尾'.'（如 example.com.）
+    static constexpr bool allow_trailing_dot = false;
+    // IPv4各段允许前导零（按十进制解释，如 010 -> 10）
+    static constexpr bool allow_leading_zero = false;
+};
+
+// SRV风格的服务名：允许'_'和结尾的'.'
+struct srv_host_policy : default_host_policy {
+    static constexpr bool allow_underscore = true;
+    static constexpr bool allow_trailing_dot = true;
+};
+
+// 主机字符分类表
+enum host_char_class {
+    HC_OTHER    = 0,
+    HC_DIGIT    = 1 << 0,
+    HC_ALPHA    = 1 << 1,
+    HC_HEX      = 1 << 2,
+    HC_DANGER   = 1 << 3,
+};
+
+struct HostCharTable {
+    unsigned char cls[256];
+    constexpr HostCharTable() : cls() {
+        for (int c = '0'; c <= '9'; c++) cls[c] = HC_DIGIT | HC_HEX;
+        for (int c = 'a'; c <= 'z'; c++) cls[c] = HC_ALPHA;
+        for (int c = 'A'; c <= 'Z'; c++) cls[c] = HC_ALPHA;
+        for (int c = 'a'; c <= 'f'; c++) cls[c] |= HC_HEX;
+        for (int c = 'A'; c <= 'F'; c++) cls[c] |= HC_HEX;
+        const char danger[] = ";<>|&`$(){}[]\"'\\*?~^!";
+        for (const char* p = danger; *p; p++) cls[static_cast<unsigned char>(*p)] = HC_DANGER;
+    }
+};
+
+inline constexpr HostCharTable HOST_CHARS;
+
+inline unsigned char host_char_class_of(char c) {
+    return HOST_CHARS.cls[static_cast<unsigned char>(c)];
+}
+
+template <typename Policy>
+class HostValidator {
+public:
+    // 分类验证，返回主机类型；addr非空时输出网络字节序地址（见classify_host）
+    static host_kind classify(std::string_view host, unsigned char* addr = nullptr) {
+        if (host.empty()) {
+            metrics_note_reject(REJECT_EMPTY);
+            return HOST_INVALID;
+        }
+        size_t max_len = 253;
+        if constexpr (Policy::allow_trailing_dot) {
+            if (host.back() == '.') max_len++;
+        }
+        if (host.length() > max_len) {
+            metrics_note_reject(REJECT_TOO_LONG);
+            return HOST_INVALID;
+        }
+
+        // 一次扫描：危险字符 ;<>|&`$(){}[]"'\*?~^!（任何策略都拒绝）、是否含'.'/':'、是否只有数字和'.'
+        bool has_dot = false;
+        bool has_colon = false;
+        bool digits_and_dots = true;
+        for (char c : host) {
+            unsigned char cls = host_char_class_of(c);
+            if (cls & HC_DANGER) {
+                metrics_note_reject(REJECT_DANGEROUS_CHAR);
+                return HOST_INVALID;
+            }
+            if (c == '.') {
+                has_dot = true;
+            } else {
+                if (c == ':') has_colon = true;
+                if (!(cls & HC_DIGIT)) digits_and_dots = false;
+            }
+        }
+
+        if (has_dot && digits_and_dots) {
+            return classify_ipv4(host, addr) ? HOST_IPV4 : HOST_INVALID;
+        }
+
+        if (has_colon) {
+            if (!classify_ipv6(host)) {
+                return HOST_INVALID;
+            }
+            if (addr) {
+                // 校验通过的标准写法不超过INET6_ADDRSTRLEN，非标准写法由inet_pton拒绝
+                char buf[256];
+                host.copy(buf, host.size());
+                buf[host.size()] = '\0';
+                if (inet_pton(AF_INET6, buf, addr) != 1) {
+                    metrics_note_reject(REJECT_BAD_FORMAT);
+                    return HOST_INVALID;
+                }
+            }
+            return HOST_IPV6;
+        }
+
+        return classify_domain(host) ? HOST_DOMAIN : HOST_INVALID;
+    }
+
+    static bool validate(std::string_view host) {
+        return classify(host) != HOST_INVALID;
+    }
+
+private:
+    // IPv4（按getline语义，末尾的一个'.'被忽略）
+    static bool classify_ipv4(std::string_view ip, unsigned char* out) {
+        if (!ip.empty() && ip.back() == '.') {
+            ip.remove_suffix(1);
+        }
+        if (ip.empty()) {
+            metrics_note_reject(REJECT_OCTET_COUNT);
+            return false;
+        }
+
+        unsigned char octets[4];
+        size_t count = 0;
+        size_t start = 0;
+        for (;;) {
+            size_t dot = ip.find('.', start);
+            std::string_view oct = ip.substr(start, dot == std::string_view::npos
+                                                        ? std::string_view::npos : dot - start);
+            if (count == 4) {
+                metrics_note_reject(REJECT_OCTET_COUNT);
+                return false;
+            }
+            if (oct.empty()) {
+                metrics_note_reject(REJECT_BAD_OCTET);
+                return false;
+            }
+            if constexpr (!Policy::allow_leading_zero) {
+                if (oct.length() > 1 && oct[0] == '0') {
+                    metrics_note_reject(REJECT_LEADING_ZERO);
+                    return false;
+                }
+            }
+            if (oct.length() > 3) {
+                metrics_note_reject(REJECT_BAD_OCTET);
+                return false;
+            }
+            unsigned value = 0;
+            for (char c : oct) {
+                if (!(host_char_class_of(c) & HC_DIGIT)) {
+                    metrics_note_reject(REJECT_BAD_OCTET);
+                    return false;
+                }
+                value = value * 10 + static_cast<unsigned>(c - '0');
+            }
+            if (value > 255) {
+                metrics_note_reject(REJECT_BAD_OCTET);
+                return false;
+            }
+            octets[count++] = static_cast<unsigned char>(value);
+            if (dot == std::string_view::npos) break;
+            start = dot + 1;
+        }
+        if (count != 4) {
+            metrics_note_reject(REJECT_OCTET_COUNT);
+            return false;
+        }
+        if (out) {
+            for (int i = 0; i < 4; i++) out[i] = octets[i];
+        }
+        return true;
+    }
+
+    // 校验一段以':'分隔的IPv6分组，skip_empty为true时跳过空分组（"::"两侧的getline语义）
+    // 返回分组数，出错返回-1
+    static int count_hex_groups(std::string_view part, bool skip_empty) {
+        if (part.empty()) {
+            return 0;
+        }
+        int groups = 0;
+        size_t start = 0;
+        for (;;) {
+            size_t colon = part.find(':', start);
+            size_t len = (colon == std::string_view::npos ? part.size() : colon) - start;
+            bool last = (colon == std::string_view::npos);
+            // getline不产生末尾的空段
+            if (len == 0 && (skip_empty || last)) {
+                if (last) break;
+                start = colon + 1;
+                continue;
+            }
+            if (len == 0 || len > 4) {
+                metrics_note_reject(REJECT_BAD_HEX_GROUP);
+                return -1;
+            }
+            for (size_t i = start; i < start + len; i++) {
+                if (!(host_char_class_of(part[i]) & HC_HEX)) {
+                    metrics_note_reject(REJECT_BAD_HEX_GROUP);
+                    return -1;
+                }
+            }
+            groups++;
+            if (last) break;
+            start = colon + 1;
+        }
+        return groups;
+    }
+
+    // 纯十六进制形式：最多一个"::"，有"::"时分组数小于8，否则恰好8组
+    static bool classify_ipv6_hex(std::string_view ip) {
+        size_t first = ip.find("::");
+        if (first != std::string_view::npos && ip.find("::", first + 2) != std::string_view::npos) {
+            metrics_note_reject(REJECT_DOUBLE_COLON);
+            return false;
+        }
+
+        if (first != std::string_view::npos) {
+            int before = count_hex_groups(ip.substr(0, first), true);
+            if (before < 0) return false;
+            int after = count_hex_groups(ip.substr(first + 2), true);
+            if (after < 0) return false;
+            if (before + after >= 8) {
+                metrics_note_reject(REJECT_GROUP_COUNT);
+                return false;
+            }
+            return true;
+        }
+
+        int groups = count_hex_groups(ip, false);
+        if (groups < 0) return false;
+        if (groups != 8) {
+            metrics_note_reject(REJECT_GROUP_COUNT);
+            return false;
+        }
+        return true;
+    }
+
+    static bool classify_ipv6(std::string_view ip) {
+        if (ip == "::" || ip == "::1") return true;
+
+        size_t last_colon = ip.rfind(':');
+        if (last_colon != std::string_view::npos && last_colon < ip.length() - 1) {
+            std::string_view last_part = ip.substr(last_colon + 1);
+            if (last_part.find('.') != std::string_view::npos) {
+                // IPv4映射形式：IPv4部分无效时整体也无效（剩余部分含'.'不可能通过十六进制校验）
+                if (!classify_ipv4(last_part, nullptr)) {
+                    return false;
+                }
+                // 以"0"代替IPv4部分校验前面的十六进制分组
+                char buf[256];
+                size_t n = last_colon + 1;
+                ip.copy(buf, n);
+                buf[n] = '0';
+                return classify_ipv6_hex(std::string_view(buf, n + 1));
+            }
+        }
+        return classify_ipv6_hex(ip);
+    }
+
+    // 域名：标签1-63个字母数字或连字符，首尾不能是连字符
+    static bool classify_domain(std::string_view domain) {
+        if constexpr (Policy::allow_trailing_dot) {
+            if (domain.size() > 1 && domain.back() == '.') {
+                domain.remove_suffix(1);
+            }
+        }
+        size_t start = 0;
+        for (;;) {
+            size_t dot = domain.find('.', start);
+            size_t end = dot == std::string_view::npos ? domain.size() : dot;
+            size_t len = end - start;
+            if (len == 0) {
+                metrics_note_reject(REJECT_LABEL_EMPTY);
+                return false;
+            }
+            if (len > 63) {
+                metrics_note_reject(REJECT_LABEL_TOO_LONG);
+                return false;
+            }
+            for (size_t i = start; i < end; i++) {
+                char c = domain[i];
+                if (host_char_class_of(c) & (HC_DIGIT | HC_ALPHA)) continue;
+                if (c == '-') continue;
+                if constexpr (Policy::allow_underscore) {
+                    if (c == '_') continue;
+                }
+                metrics_note_reject(REJECT_BAD_CHAR);
+                return false;
+            }
+            if (domain[start] == '-' || domain[end - 1] == '-') {
+                metrics_note_reject(REJECT_LABEL_HYPHEN);
+                return false;
+            }
+            if (dot == std::string_view::npos) break;
+            start = dot + 1;
+        }
+        return true;
+    }
+};
+
+#endif // HOST_POLICY_H
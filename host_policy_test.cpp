@@ -0,0 +1,69 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+
+#include "host_validator.h"
+#include "host_policy.h"
+
+using namespace std;
+
+static int g_passed = 0;
+static int g_total = 0;
+
+static void check(const string& name, bool ok) {
+    g_total++;
+    cout << "测试: " << name << " ";
+    if (ok) {
+        cout << "✓ 通过" << endl;
+        g_passed++;
+    } else {
+        cout << "✗ 失败" << endl;
+    }
+}
+
+// 测试用策略
+struct leading_zero_policy : default_host_policy {
+    static constexpr bool allow_leading_zero = true;
+};
+
+int main() {
+    cout << "=== HostValidator 策略测试 ===" << endl;
+
+    typedef HostValidator<default_host_policy> Default;
+    typedef HostValidator<srv_host_policy> Srv;
+    typedef HostValidator<leading_zero_policy> LeadingZero;
+
+    check("默认策略拒绝'_'", !Default::validate("_sip._tcp.example.com"));
+    check("SRV策略允许'_'", Srv::validate("_sip._tcp.example.com"));
+    check("默认策略拒绝结尾'.'", !Default::validate("example.com."));
+    check("SRV策略允许结尾'.'", Srv::validate("example.com.") && Srv::validate("_srv.example.com."));
+    check("SRV策略仍拒绝单独的'.'和'..'", !Srv::validate(".") && !Srv::validate("example.com.."));
+    check("SRV策略结尾'.'不计入253字节", Srv::validate(string(63, 'a') + "." + string(63, 'b') + "." +
+                                                       string(63, 'c') + "." + string(61, 'd') + "."));
+    check("SRV策略仍拒绝连字符开头", !Srv::validate("-a.example.com"));
+
+    unsigned char addr[16] = {0};
+    check("默认策略拒绝前导零", !Default::validate("10.0.0.01"));
+    check("前导零策略按十进制解析", LeadingZero::classify("010.001.0.9", addr) == HOST_IPV4 &&
+                                    addr[0] == 10 && addr[1] == 1 && addr[3] == 9);
+    check("前导零策略仍限制255", !LeadingZero::validate("1.2.3.0256") && !LeadingZero::validate("1.2.3.256"));
+
+    check("默认策略危险字符", !Default::validate("a;b.com"));
+    check("SRV策略同样拒绝危险字符", !Srv::validate("_a;b.com") && !Srv::validate("a$(b).com."));
+
+    // 默认策略实例与参考实现逐条一致
+    const string alphabet = "0123456789abcdefABCDEF.:-_;$ xyz";
+    mt19937 rng(41);
+    size_t mismatches = 0;
+    for (int i = 0; i < 300000; i++) {
+        string s;
+        size_t n = rng() % 24;
+        for (size_t j = 0; j < n; j++) s += alphabet[rng() % alphabet.size()];
+        if (is_valid_host(s) != is_valid_host_reference(s)) mismatches++;
+    }
+    check("默认策略与参考实现一致", mismatches == 0);
+
+    cout << endl << "测试结果: " << g_passed << "/" << g_total << " 通过" << endl;
+    return g_passed == g_total ? 0 : 1;
+}
@@ -1,20 +1,45 @@
 #include <string>
 #include <vector>
-#include <regex>
 #include <sstream>
 #include <cctype>
 #include <cstdlib>
 #include "host_validator.h"
+#include "host_policy.h"
+#include "validation_metrics.h"
+#include "shadow_verify.h"
 
 using namespace std;
 
-class HostValidator {
+// 参考实现：按原始规则逐项校验（字符串切分），
+// 作为HostValidator<default_host_policy>的行为基准，供影子校验比对
+class ReferenceHostValidator {
 private:
     // 危险字符列表，用于防止注入攻击
     static const string DANGEROUS_CHARS;
     
-    // 域名正则表达式
-    static const regex DOMAIN_PATTERN;
+    /**
+     * 域名基本格式，与原正则
+     *   ^[a-zA-Z0-9]([a-zA-Z0-9\-]{0,61}[a-zA-Z0-9])?(\.[a-zA-Z0-9]([a-zA-Z0-9\-]{0,61}[a-zA-Z0-9])?)*$
+     * 等价：以'.'分隔的非空标签，每个标签不超过63字符、只含字母数字和'-'、首尾为字母数字。
+     * std::regex是回溯实现，构造的输入可能耗时很长甚至栈溢出，这里改为一次线性扫描
+     */
+    static bool matchesDomainPattern(const string& domain) {
+        size_t label_len = 0;
+        char prev = '.';
+        for (char c : domain) {
+            if (c == '.') {
+                if (label_len == 0 || prev == '-') return false;
+                label_len = 0;
+            } else if (isalnum(static_cast<unsigned char>(c)) || c == '-') {
+                if (label_len == 0 && c == '-') return false;
+                if (++label_len > 63) return false;
+            } else {
+                return false;
+            }
+            prev = c;
+        }
+        return label_len > 0 && prev != '-';
+    }
 
     /**
      * 验证纯IPv6十六进制格式的辅助函数
@@ -29,6 +54,7 @@ private:
         }
         
         if (doubleColonCount > 1) {
+            metrics_note_reject(REJECT_DOUBLE_COLON);
             return false;
         }
         
@@ -57,7 +83,10 @@ private:
             }
             
             // 双冒号表示零压缩，总段数不能超过8
-            if (segments.size() >= 8) return false;
+            if (segments.size() >= 8) {
+                metrics_note_reject(REJECT_GROUP_COUNT);
+                return false;
+            }
         } else {
             // 没有双冒号，必须有8段
             stringstream ss(ip);
@@ -65,17 +94,22 @@ private:
             while (getline(ss, segment, ':')) {
                 segments.push_back(segment);
             }
-            if (segments.size() != 8) return false;
+            if (segments.size() != 8) {
+                metrics_note_reject(REJECT_GROUP_COUNT);
+                return false;
+            }
         }
         
         // 验证每个段
         for (const string& segment : segments) {
             if (segment.length() > 4 || segment.empty()) {
+                metrics_note_reject(REJECT_BAD_HEX_GROUP);
                 return false;
             }
             
             for (char c : segment) {
                 if (!isxdigit(c)) {
+                    metrics_note_reject(REJECT_BAD_HEX_GROUP);
                     return false;
                 }
             }
@@ -84,6 +118,28 @@ private:
         return true;
     }
 
+    /**
+     * 域名正则匹配失败时细分拒绝原因（仅在开启统计时调用）
+     */
+    reject_reason classifyDomainReject(const string& domain) const {
+        for (char c : domain) {
+            if (!isalnum(static_cast<unsigned char>(c)) && c != '-' && c != '.') {
+                return REJECT_BAD_CHAR;
+            }
+        }
+        size_t start = 0;
+        while (start <= domain.length()) {
+            size_t dot = domain.find('.', start);
+            if (dot == string::npos) dot = domain.length();
+            size_t len = dot - start;
+            if (len == 0) return REJECT_LABEL_EMPTY;
+            if (len > 63) return REJECT_LABEL_TOO_LONG;
+            if (domain[start] == '-' || domain[dot - 1] == '-') return REJECT_LABEL_HYPHEN;
+            start = dot + 1;
+        }
+        return REJECT_BAD_FORMAT;
+    }
+
 public:
     /**
      * 检查字符串是否包含危险字符
@@ -106,29 +162,43 @@ public:
         }
         
         // 必须有4段
-        if (octets.size() != 4) return false;
+        if (octets.size() != 4) {
+            metrics_note_reject(REJECT_OCTET_COUNT);
+            return false;
+        }
         
         for (const string& oct : octets) {
             // 检查空段
-            if (oct.empty()) return false;
+            if (oct.empty()) {
+                metrics_note_reject(REJECT_BAD_OCTET);
+                return false;
+            }
             
             // 检查前导零（除了"0"本身）
             if (oct.length() > 1 && oct[0] == '0') {
+                metrics_note_reject(REJECT_LEADING_ZERO);
                 return false;
             }
             
             // 检查是否只包含数字
             for (char c : oct) {
-                if (!isdigit(c)) return false;
+                if (!isdigit(c)) {
+                    metrics_note_reject(REJECT_BAD_OCTET);
+                    return false;
+                }
             }
             
             // 检查长度（最多3位）
-            if (oct.length() > 3) return false;
+            if (oct.length() > 3) {
+                metrics_note_reject(REJECT_BAD_OCTET);
+                return false;
+            }
             
             // 转换为数字并检查范围
             char* endptr = nullptr;
             long num = strtol(oct.c_str(), &endptr, 10);
             if (*endptr != '\0' || num < 0 || num > 255) {
+                metrics_note_reject(REJECT_BAD_OCTET);
                 return false;
             }
         }
@@ -166,16 +236,26 @@ public:
      */
     bool isValidDomain(const string& domain) const {
         // 长度检查
-        if (domain.length() > 253) return false;
-        if (domain.empty()) return false;
+        if (domain.length() > 253) {
+            metrics_note_reject(REJECT_TOO_LONG);
+            return false;
+        }
+        if (domain.empty()) {
+            metrics_note_reject(REJECT_EMPTY);
+            return false;
+        }
         
         // 基本格式检查
-        if (!regex_match(domain, DOMAIN_PATTERN)) {
+        if (!matchesDomainPattern(domain)) {
+            if (metrics_enabled()) {
+                metrics_note_reject(classifyDomainReject(domain));
+            }
             return false;
         }
         
         // 不能以点开始或结束
         if (domain[0] == '.' || domain.back() == '.') {
+            metrics_note_reject(REJECT_LABEL_EMPTY);
             return false;
         }
         
@@ -185,11 +265,17 @@ public:
         string label;
         
         while (getline(ss, label, '.')) {
-            if (label.length() > 63 || label.empty()) {
+            if (label.empty()) {
+                metrics_note_reject(REJECT_LABEL_EMPTY);
+                return false;
+            }
+            if (label.length() > 63) {
+                metrics_note_reject(REJECT_LABEL_TOO_LONG);
                 return false;
             }
             // 标签不能以连字符开始或结束
             if (label[0] == '-' || label.back() == '-') {
+                metrics_note_reject(REJECT_LABEL_HYPHEN);
                 return false;
             }
             labels.push_back(label);
@@ -218,12 +304,18 @@ public:
      */
     bool validate(const string& host) const {
         // 基本安全检查
-        if (host.empty() || host.length() > 253) {
+        if (host.empty()) {
+            metrics_note_reject(REJECT_EMPTY);
+            return false;
+        }
+        if (host.length() > 253) {
+            metrics_note_reject(REJECT_TOO_LONG);
             return false;
         }
         
         // 检查危险字符
         if (containsDangerousChars(host)) {
+            metrics_note_reject(REJECT_DANGEROUS_CHAR);
             return false;
         }
         
@@ -244,17 +336,43 @@ public:
 };
 
 // 静态成员定义
-const string HostValidator::DANGEROUS_CHARS = ";<>|&`$(){}[]\"'\\*?~^!";
+const string ReferenceHostValidator::DANGEROUS_CHARS = ";<>|&`$(){}[]\"'\\*?~^!";
 
-// 保留域名正则表达式
-const regex HostValidator::DOMAIN_PATTERN(
-    R"(^[a-zA-Z0-9]([a-zA-Z0-9\-]{0,61}[a-zA-Z0-9])?(\.[a-zA-Z0-9]([a-zA-Z0-9\-]{0,61}[a-zA-Z0-9])?)*$)"
-);
+/**
+ * 参考实现
+ */
+bool is_valid_host_reference(const string& host) {
+    // 校验器没有状态，每次在栈上构造，避免函数内静态对象的初始化检查
+    return ReferenceHostValidator().validate(host);
+}
+
+/**
+ * 影子校验的参考结果
+ */
+static string shadow_reference_host(const string& host) {
+    return is_valid_host_reference(host) ? "1" : "0";
+}
 
 /**
  * 主要的验证函数
  */
 bool is_valid_host(const string& host) {
-    static HostValidator validator;
-    return validator.validate(host);
+    return is_valid_host_view(host);
+}
+
+bool is_valid_host_view(string_view host) {
+    MetricTimer timer(METRIC_IS_VALID_HOST);
+    bool ok = timer.finish(HostValidator<default_host_policy>::validate(host));
+    if (shadow_should_sample()) {
+        // 只有抽中的调用才复制输入
+        shadow_submit(SHADOW_IS_VALID_HOST, string(host), ok ? "1" : "0", shadow_reference_host);
+    }
+    return ok;
+}
+
+// ===========================================
+// 快速路径：默认策略的实例化（见host_policy.h）
+// ===========================================
+host_kind classify_host(string_view host, unsigned char* addr) {
+    return HostValidator<default_host_policy>::classify(host, addr);
 }
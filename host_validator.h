@@ -1,3 +1,34 @@
+#ifndef HOST_VALIDATOR_H
+#define HOST_VALIDATOR_H
+
 #include <string>
+#include <string_view>
 
+// 验证主机地址（IPv4、IPv6或域名）
+// 即HostValidator<default_host_policy>；需要其他规则时见host_policy.h
 bool is_valid_host(const std::string& host);
+
+// 同is_valid_host，输入为指针+长度，不构造std::string（统计和影子校验照常进行）
+// 供C ABI等已持有原始缓冲区的调用方使用
+bool is_valid_host_view(std::string_view host);
+
+// 参考实现：使用独立冻结的ReferenceHostValidator，刻意不经过HostValidator<Policy>，
+// 也不经过统计和影子校验；供shadow_verify在后台比对快速路径的结果
+bool is_valid_host_reference(const std::string& host);
+
+// 主机地址类型
+enum host_kind {
+    HOST_INVALID = 0,
+    HOST_IPV4,
+    HOST_IPV6,
+    HOST_DOMAIN,
+};
+
+// 分类验证主机地址，接受规则与is_valid_host相同
+// 一次扫描完成分类和危险字符检查，再按类型做一次校验，不构造临时字符串
+// addr非空时同时输出网络字节序的二进制地址（IPv4写4字节，IPv6写16字节）；
+// 此时IPv6必须是可转换的标准文本形式，is_valid_host出于兼容接受的
+// ":::"、"1:2:3:4:5:6:7:8:" 等非标准写法视为HOST_INVALID
+host_kind classify_host(std::string_view host, unsigned char* addr = nullptr);
+
+#endif // HOST_VALIDATOR_H
@@ -0,0 +1,267 @@
+#include "hostname_pool.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// 16字节块，按两个64位字参与哈希和比较
+struct chunk16 {
+  uint64_t lo;
+  uint64_t hi;
+};
+
+// 取p开始的最多16字节（不足补0）并把'A'-'Z'转成小写
+#if defined(__SSE2__)
+static inline chunk16 fold_chunk(const char* p, size_t n) {
+  __m128i v;
+  if (n >= 16) {
+    v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+  } else {
+    char buf[16] = {0};
+    memcpy(buf, p, n);
+    v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buf));
+  }
+  // 有符号比较：0x80以上的字节为负数，不会落在'A'-'Z'之间
+  __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)),
+                                _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+  v = _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+  chunk16 c;
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(&c), v);
+  return c;
+}
+#else
+// 一次处理8字节：每个字节的最高位标记该字节是否为大写字母
+static inline uint64_t fold_word(uint64_t w) {
+  const uint64_t ones = 0x0101010101010101ULL;
+  uint64_t low7 = w & (0x7F * ones);
+  uint64_t ge_a = low7 + (0x80 - 'A') * ones;     // 最高位为1表示 >= 'A'
+  uint64_t gt_z = low7 + (0x7F - 'Z') * ones;     // 最高位为1表示 > 'Z'
+  uint64_t upper = ge_a & ~gt_z & ~w & (0x80 * ones);
+  return w | (upper >> 2);
+}
+
+static inline chunk16 fold_chunk(const char* p, size_t n) {
+  char buf[16] = {0};
+  memcpy(buf, p, n < 16 ? n : 16);
+  chunk16 c;
+  memcpy(&c, buf, sizeof(c));
+  c.lo = fold_word(c.lo);
+  c.hi = fold_word(c.hi);
+  return c;
+}
+#endif
+
+// 取p开始的最多16字节，不足补0，不做转换
+static inline chunk16 load_chunk(const char* p, size_t n) {
+  chunk16 c = {0, 0};
+  memcpy(&c, p, n < 16 ? n : 16);
+  return c;
+}
+
+static inline uint64_t rotl64(uint64_t x, int r) {
+  return (x << r) | (x >> (64 - r));
+}
+
+static const uint64_t HASH_K1 = 0x9E3779B97F4A7C15ULL;
+static const uint64_t HASH_K2 = 0xC2B2AE3D27D4EB4FULL;
+
+uint64_t hostname_hash(std::string_view name) {
+  const char* p = name.data();
+  size_t n = name.size();
+  uint64_t h = n * HASH_K1;
+  for (size_t off = 0; off < n; off += 16) {
+    chunk16 c = fold_chunk(p + off, n - off);
+    h ^= c.lo * HASH_K2;
+    h = rotl64(h, 29) * HASH_K1;
+    h ^= c.hi * HASH_K1;
+    h = rotl64(h, 31) * HASH_K2;
+  }
+  // murmur3的fmix64，让低位也充分混合（索引只用低位）
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDULL;
+  h ^= h >> 33;
+  h *= 0xC4CEB9FE1A85EC53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+// stored已是小写，input按需折叠后逐块比较，两者长度均为n
+static bool equal_nocase(const char* stored, const char* input, size_t n) {
+  for (size_t off = 0; off < n; off += 16) {
+    chunk16 a = load_chunk(stored + off, n - off);
+    chunk16 b = fold_chunk(input + off, n - off);
+    if (a.lo != b.lo || a.hi != b.hi) {
+      return false;
+    }
+  }
+  return true;
+}
+
+const uint32_t HostnamePool::NPOS;
+
+HostnamePool::HostnamePool(size_t expected) {
+  size_t capacity = 16;
+  while (capacity * 3 < expected * 4) {
+    capacity *= 2;
+  }
+  slots_.assign(capacity, NPOS);
+  offsets_.reserve(expected + 1);
+  offsets_.push_back(0);
+  hashes_.reserve(expected);
+}
+
+size_t HostnamePool::probe(uint64_t hash, std::string_view name, bool folded) const {
+  size_t mask = slots_.size() - 1;
+  size_t i = hash & mask;
+  for (;;) {
+    uint32_t id = slots_[i];
+    if (id == NPOS) {
+      return i;
+    }
+    if (hashes_[id] == hash && offsets_[id + 1] - offsets_[id] == name.size()) {
+      const char* stored = arena_.data() + offsets_[id];
+      if (folded ? memcmp(stored, name.data(), name.size()) == 0
+                 : equal_nocase(stored, name.data(), name.size())) {
+        return i;
+      }
+    }
+    i = (i + 1) & mask;
+  }
+}
+
+uint32_t HostnamePool::insert_at(size_t slot, uint64_t hash, std::string_view name, bool folded) {
+  size_t start = arena_.size();
+  if (name.size() > 0xFFFFFFFFu - start || hashes_.size() >= NPOS - 1) {
+    return NPOS;
+  }
+  arena_.resize(start + name.size());
+  char* dst = arena_.data() + start;
+  if (folded) {
+    memcpy(dst, name.data(), name.size());
+  } else {
+    for (size_t off = 0; off < name.size(); off += 16) {
+      size_t n = name.size() - off;
+      chunk16 c = fold_chunk(name.data() + off, n);
+      memcpy(dst + off, &c, n < 16 ? n : 16);
+    }
+  }
+  uint32_t id = static_cast<uint32_t>(hashes_.size());
+  offsets_.push_back(static_cast<uint32_t>(arena_.size()));
+  hashes_.push_back(hash);
+  slots_[slot] = id;
+  return id;
+}
+
+// 容量翻倍，按保存的哈希值重新放置，名字互不相同，不需要比较
+void HostnamePool::grow() {
+  std::vector<uint32_t> slots(slots_.size() * 2, NPOS);
+  size_t mask = slots.size() - 1;
+  for (uint32_t id = 0; id < hashes_.size(); id++) {
+    size_t i = hashes_[id] & mask;
+    while (slots[i] != NPOS) {
+      i = (i + 1) & mask;
+    }
+    slots[i] = id;
+  }
+  slots_.swap(slots);
+}
+
+uint32_t HostnamePool::intern(std::string_view name) {
+  // 装载因子不超过3/4
+  if ((hashes_.size() + 1) * 4 > slots_.size() * 3) {
+    grow();
+  }
+  uint64_t hash = hostname_hash(name);
+  size_t slot = probe(hash, name, false);
+  if (slots_[slot] != NPOS) {
+    return slots_[slot];
+  }
+  return insert_at(slot, hash, name, false);
+}
+
+uint32_t HostnamePool::find(std::string_view name) const {
+  return slots_[probe(hostname_hash(name), name, false)];
+}
+
+bool HostnamePool::merge(const HostnamePool& other, std::vector<uint32_t>* remap) {
+  if (remap != nullptr) {
+    remap->assign(other.size(), NPOS);
+  }
+  for (uint32_t id = 0; id < other.size(); id++) {
+    if ((hashes_.size() + 1) * 4 > slots_.size() * 3) {
+      grow();
+    }
+    std::string_view name = other.name(id);
+    uint64_t hash = other.hashes_[id];
+    size_t slot = probe(hash, name, true);
+    uint32_t mine = slots_[slot];
+    if (mine == NPOS) {
+      mine = insert_at(slot, hash, name, true);
+      if (mine == NPOS) {
+        return false;
+      }
+    }
+    if (remap != nullptr) {
+      (*remap)[id] = mine;
+    }
+  }
+  return true;
+}
+
+HostnamePool HostnamePool::build_parallel(const std::vector<std::string>& names, unsigned threads,
+                                          std::vector<uint32_t>* ids) {
+  size_t count = names.size();
+  if (threads == 0) {
+    threads = 1;
+  }
+  if (threads > count) {
+    threads = count == 0 ? 1 : static_cast<unsigned>(count);
+  }
+  size_t per_thread = (count + threads - 1) / threads;
+
+  // 各线程处理连续区间：区间内按顺序intern，合并时也按区间顺序，
+  // 因此每个名字的最终id就是它在整个输入中首次出现的次序
+  std::vector<HostnamePool> locals;
+  locals.reserve(threads);
+  for (unsigned t = 0; t < threads; t++) {
+    locals.emplace_back(per_thread);
+  }
+  if (ids != nullptr) {
+    ids->assign(count, NPOS);
+  }
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < threads; t++) {
+    workers.emplace_back([&, t]() {
+      size_t begin = t * per_thread;
+      size_t end = std::min(count, begin + per_thread);
+      for (size_t i = begin; i < end; i++) {
+        uint32_t id = locals[t].intern(names[i]);
+        if (ids != nullptr) {
+          (*ids)[i] = id;
+        }
+      }
+    });
+  }
+  for (std::thread& w : workers) {
+    w.join();
+  }
+
+  HostnamePool result = std::move(locals[0]);
+  std::vector<uint32_t> remap;
+  for (unsigned t = 1; t < threads; t++) {
+    result.merge(locals[t], ids != nullptr ? &remap : nullptr);
+    if (ids != nullptr) {
+      size_t begin = t * per_thread;
+      size_t end = std::min(count, begin + per_thread);
+      for (size_t i = begin; i < end; i++) {
+        uint32_t local = (*ids)[i];
+        (*ids)[i] = local == NPOS ? NPOS : remap[local];
+      }
+    }
+    // 合并后立即释放局部池
+    locals[t] = HostnamePool();
+  }
+  return result;
+}
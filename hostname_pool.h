@@ -0,0 +1,66 @@
+#ifndef HOSTNAME_POOL_H_
+#define HOSTNAME_POOL_H_
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// ===========================================
+// 不区分大小写的主机名去重池，用于从日志汇总上千万个主机名
+// 名字统一转成小写后连续存放在一块arena中，id为32位、从0开始连续分配（按首次出现顺序）；
+// 索引是线性探测的开放寻址表，只存id，哈希值按id另存一份，扩容和合并时不重新计算。
+// 每个名字除自身字节外约占17字节（unordered_set<std::string>为60字节以上）
+// 池本身不做校验和规范化，调用方应先用is_valid_host()校验、fix_domain_name()规范化
+// ===========================================
+
+// 不区分ASCII大小写的64位哈希，"Example.COM"与"example.com"相同
+// 每次按16字节折叠大小写（SSE2，无SSE2时用64位SWAR），不复制输入
+uint64_t hostname_hash(std::string_view name);
+
+class HostnamePool {
+public:
+  static const uint32_t NPOS = 0xFFFFFFFFu;
+
+  // expected为预计的名字数，用于预分配索引
+  explicit HostnamePool(size_t expected = 0);
+
+  // 驻留一个名字，返回其id；已存在（不区分大小写）时返回原id
+  // arena超过4GB或id用尽时返回NPOS
+  uint32_t intern(std::string_view name);
+
+  // 查找名字，不存在时返回NPOS
+  uint32_t find(std::string_view name) const;
+
+  // 按id取名字（小写）
+  std::string_view name(uint32_t id) const {
+    return std::string_view(arena_.data() + offsets_[id], offsets_[id + 1] - offsets_[id]);
+  }
+
+  size_t size() const { return hashes_.size(); }
+  size_t arena_bytes() const { return arena_.size(); }
+
+  // 把other中的名字按other的id顺序并入本池，沿用other中保存的哈希值
+  // remap非空时，(*remap)[i]为other中id i在本池中的id
+  // 失败（arena或id用尽）时返回false，已并入的名字保留
+  bool merge(const HostnamePool& other, std::vector<uint32_t>* remap = nullptr);
+
+  // 用threads个线程并行构建：输入按连续区间分给各线程各自建池，再依次合并
+  // 结果的id与单线程按顺序intern完全相同；ids非空时(*ids)[i]为names[i]的id
+  static HostnamePool build_parallel(const std::vector<std::string>& names, unsigned threads,
+                                     std::vector<uint32_t>* ids = nullptr);
+
+private:
+  // 在索引中查找已折叠为小写的名字，返回其槽位；不存在时返回空槽位
+  size_t probe(uint64_t hash, std::string_view name, bool folded) const;
+  uint32_t insert_at(size_t slot, uint64_t hash, std::string_view name, bool folded);
+  void grow();
+
+  std::vector<char> arena_;           // 所有名字的小写形式，首尾相接
+  std::vector<uint32_t> offsets_;     // 名字i为arena_[offsets_[i], offsets_[i + 1])
+  std::vector<uint64_t> hashes_;      // 名字i的哈希值
+  std::vector<uint32_t> slots_;       // 开放寻址索引，存id，NPOS为空；容量为2的幂
+};
+
+#endif  // HOSTNAME_POOL_H_
@@ -0,0 +1,118 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <unordered_map>
+
+#include "hostname_pool.h"
+
+using namespace std;
+
+static int g_passed = 0;
+static int g_total = 0;
+
+static void check(const string& name, bool ok) {
+    g_total++;
+    cout << "测试: " << name << " ";
+    if (ok) {
+        cout << "✓ 通过" << endl;
+        g_passed++;
+    } else {
+        cout << "✗ 失败" << endl;
+    }
+}
+
+static string lower(string s) {
+    for (char& c : s) {
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+    }
+    return s;
+}
+
+// 随机主机名，大小写随机；取值空间较小以产生大量重复
+static vector<string> random_names(size_t count, unsigned seed) {
+    mt19937 rng(seed);
+    const char alphabet[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789-.";
+    vector<string> names;
+    names.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        size_t len = 1 + rng() % 40;
+        string s;
+        for (size_t j = 0; j < len; j++) {
+            s += alphabet[rng() % 8 + (rng() % 2) * 26];     // a-h/A-H
+        }
+        s += ".example.com";
+        if (rng() % 4 == 0) s[rng() % s.size()] = alphabet[rng() % (sizeof(alphabet) - 1)];
+        names.push_back(s);
+    }
+    return names;
+}
+
+int main() {
+    cout << "=== 主机名去重池测试 ===" << endl;
+
+    check("哈希不区分大小写", hostname_hash("Example.COM") == hostname_hash("example.com") &&
+                              hostname_hash("WWW.VERY-LONG-HOSTNAME.EXAMPLE.ORG") ==
+                              hostname_hash("www.very-long-hostname.example.org"));
+    check("哈希区分内容和长度", hostname_hash("example.com") != hostname_hash("example.org") &&
+                                hostname_hash("a") != hostname_hash(string_view("a\0", 2)) &&
+                                hostname_hash("") != hostname_hash(string(1, '\0')));
+    // 固定值：SSE2和SWAR两种实现必须一致
+    check("哈希值与实现无关", hostname_hash("Mail.Example.COM") == 0x4e38d61aee421a8dULL);
+
+    HostnamePool pool;
+    uint32_t a = pool.intern("Example.COM");
+    uint32_t b = pool.intern("example.com");
+    uint32_t c = pool.intern("www.example.com");
+    check("大小写不同视为同一名字", a == 0 && b == 0 && c == 1 && pool.size() == 2);
+    check("按小写保存", pool.name(a) == "example.com" && pool.arena_bytes() == 26);
+    check("查找", pool.find("EXAMPLE.com") == a && pool.find("example.org") == HostnamePool::NPOS);
+    check("非ASCII字节不折叠", pool.intern("\xC3\x80.com") != pool.intern("\xC3\xA0.com") &&
+                               pool.name(pool.find("\xC3\x80.com")) == "\xC3\x80.com");
+    check("空名字", pool.intern("") == pool.intern("") && pool.name(pool.find("")).empty());
+
+    // 与unordered_map比对，覆盖多次扩容
+    vector<string> names = random_names(200000, 47);
+    HostnamePool big;
+    unordered_map<string, uint32_t> ref;
+    size_t mismatches = 0;
+    for (const string& s : names) {
+        uint32_t id = big.intern(s);
+        auto it = ref.emplace(lower(s), static_cast<uint32_t>(ref.size())).first;
+        if (it->second != id) mismatches++;
+    }
+    for (const auto& kv : ref) {
+        if (big.name(kv.second) != kv.first) mismatches++;
+    }
+    check("与unordered_map结果一致", mismatches == 0 && big.size() == ref.size() && ref.size() < names.size());
+
+    // 合并
+    HostnamePool left, right;
+    left.intern("a.com");
+    left.intern("b.com");
+    right.intern("B.COM");
+    right.intern("c.com");
+    vector<uint32_t> remap;
+    bool ok = left.merge(right, &remap);
+    check("合并", ok && left.size() == 3 && remap.size() == 2 && remap[0] == 1 && remap[1] == 2 &&
+                  left.find("C.com") == 2);
+
+    // 并行构建与顺序构建的id完全一致
+    vector<uint32_t> ids;
+    HostnamePool parallel = HostnamePool::build_parallel(names, 4, &ids);
+    mismatches = 0;
+    for (size_t i = 0; i < names.size(); i++) {
+        if (ids[i] != big.find(names[i])) mismatches++;
+    }
+    for (uint32_t id = 0; id < parallel.size(); id++) {
+        if (parallel.name(id) != big.name(id)) mismatches++;
+    }
+    check("并行构建id与顺序构建一致", mismatches == 0 && parallel.size() == big.size() &&
+                                      parallel.arena_bytes() == big.arena_bytes());
+    HostnamePool tiny = HostnamePool::build_parallel({"x.com", "X.com"}, 8, &ids);
+    check("线程数多于输入", tiny.size() == 1 && ids.size() == 2 && ids[0] == 0 && ids[1] == 0);
+    check("空输入", HostnamePool::build_parallel({}, 4).size() == 0);
+
+    cout << endl << "测试结果: " << g_passed << "/" << g_total << " 通过" << endl;
+    return g_passed == g_total ? 0 : 1;
+}
@@ -1,101 +1,475 @@
 #include "input_validation.h"
-#include <regex>
+#include "validation_metrics.h"
+#include "parse_int.h"
 #include <arpa/inet.h>
 #include <algorithm>
-#include <cctype>
+#include <cstring>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Shell命令转义：单引号包裹，内部的'替换为'\''
+// 先算出转义后的长度，再一次写入预留好的空间；
+// 两遍都用memchr按段跳过不含引号的部分，整段memcpy
+static size_t shell_quoted_length(std::string_view s) {
+    size_t len = s.size() + 2;              // 头尾包裹
+    const char* p = s.data();
+    const char* end = p + s.size();
+    while (p < end) {
+        const char* q = static_cast<const char*>(memchr(p, '\'', end - p));
+        if (q == nullptr) break;
+        len += 3;                           // ' -> '\''
+        p = q + 1;
+    }
+    return len;
+}
+
+static char* write_shell_quoted(std::string_view s, char* out) {
+    *out++ = '\'';                          // 起始单引号
+    const char* p = s.data();
+    const char* end = p + s.size();
+    while (p < end) {
+        const char* q = static_cast<const char*>(memchr(p, '\'', end - p));
+        const char* run_end = q ? q : end;
+        memcpy(out, p, run_end - p);
+        out += run_end - p;
+        if (q == nullptr) break;
+        memcpy(out, "'\\''", 4);           // 结束 -> \' -> 重新开始
+        out += 4;
+        p = q + 1;
+    }
+    *out++ = '\'';                          // 结束单引号
+    return out;
+}
+
+template <typename Str>
+static void append_shell_quoted(std::string_view s, Str& res) {
+    size_t old = res.size();
+    res.resize(old + shell_quoted_length(s));
+    write_shell_quoted(s, &res[old]);
+}
+
+template <typename Str>
+static void append_shell_command(const std::string_view* args, size_t count, Str& res) {
+    if (count == 0) {
+        return;
+    }
+    // 计算总长度：各参数转义后的长度 + 参数间的空格
+    size_t total = count - 1;
+    for (size_t i = 0; i < count; i++) {
+        total += shell_quoted_length(args[i]);
+    }
+
+    size_t old = res.size();
+    res.resize(old + total);
+    char* out = &res[old];
+    for (size_t i = 0; i < count; i++) {
+        if (i > 0) *out++ = ' ';
+        out = write_shell_quoted(args[i], out);
+    }
+}
 
 // Shell命令转义函数
 std::string shell_quote(const std::string& s) {
     std::string res;
-    res.reserve(s.size() + 2);   // 头尾包裹 + 少量引号转义
-    res += '\'';                 // 起始单引号
+    append_shell_quoted(s, res);
+    return res;
+}
 
-    for (char c : s) {
-        if (c == '\'')
-            res += "'\\''";      // 结束 -> \' -> 重新开始
-        else
-            res += c;
-    }
+std::pmr::string shell_quote(std::string_view s, std::pmr::memory_resource* mr) {
+    std::pmr::string res(mr);
+    append_shell_quoted(s, res);
+    return res;
+}
 
-    res += '\'';                 // 结束单引号
+void shell_quote_into(std::string_view str, std::string& out) {
+    append_shell_quoted(str, out);
+}
+
+void shell_quote_into(std::string_view str, std::pmr::string& out) {
+    append_shell_quoted(str, out);
+}
+
+void shell_command_into(const std::string_view* args, size_t count, std::string& out) {
+    append_shell_command(args, count, out);
+}
+
+std::string shell_command(const std::vector<std::string>& argv) {
+    // 参数较少时在栈上构造string_view数组
+    std::string_view small[16];
+    std::vector<std::string_view> large;
+    std::string_view* views = small;
+    if (argv.size() > 16) {
+        large.resize(argv.size());
+        views = large.data();
+    }
+    for (size_t i = 0; i < argv.size(); i++) {
+        views[i] = argv[i];
+    }
+    std::string res;
+    append_shell_command(views, argv.size(), res);
     return res;
 }
 
 // IP地址验证函数
 bool validate_ipv4(const std::string& ip) {
     // 使用inet_pton进行验证
+    MetricTimer timer(METRIC_VALIDATE_IPV4);
+    // inet_pton会先对整串求长度，超长输入在此直接拒绝
+    if (ip.length() >= INET_ADDRSTRLEN) {
+        return timer.reject(REJECT_TOO_LONG);
+    }
     struct sockaddr_in sa;
-    return inet_pton(AF_INET, ip.c_str(), &(sa.sin_addr)) == 1;
+    if (inet_pton(AF_INET, ip.c_str(), &(sa.sin_addr)) != 1) {
+        return timer.reject(REJECT_BAD_FORMAT);
+    }
+    return timer.pass();
 }
 
 // IPv6地址验证函数
 bool validate_ipv6(const std::string& ip) {
+    MetricTimer timer(METRIC_VALIDATE_IPV6);
+    if (ip.length() >= INET6_ADDRSTRLEN) {
+        return timer.reject(REJECT_TOO_LONG);
+    }
     struct sockaddr_in6 sa;
-    return inet_pton(AF_INET6, ip.c_str(), &(sa.sin6_addr)) == 1;
+    if (inet_pton(AF_INET6, ip.c_str(), &(sa.sin6_addr)) != 1) {
+        return timer.reject(REJECT_BAD_FORMAT);
+    }
+    return timer.pass();
 }
 
 // 子网掩码验证函数
 bool validate_netmask(const std::string& mask) {
-    // 首先验证是否为有效的IPv4地址
-    if (!validate_ipv4(mask)) {
-        return false;
+    MetricTimer timer(METRIC_VALIDATE_NETMASK);
+    if (mask.length() >= INET_ADDRSTRLEN) {
+        return timer.reject(REJECT_TOO_LONG);
     }
-    
-    // 转换为32位整数验证是否为有效掩码
-    struct sockaddr_in sa;
-    inet_pton(AF_INET, mask.c_str(), &(sa.sin_addr));
-    uint32_t mask_val = ntohl(sa.sin_addr.s_addr);
+
+    // 一次inet_pton同时完成格式验证和转换
+    struct in_addr addr;
+    if (inet_pton(AF_INET, mask.c_str(), &addr) != 1) {
+        return timer.reject(REJECT_BAD_FORMAT);
+    }
+    uint32_t mask_val = ntohl(addr.s_addr);
     
     // 有效的掩码必须是连续的1后面跟连续的0
-    if (mask_val == 0) return false;
-    
-    // 检查方法：mask_val 加 1 应该是 2 的幂
-    // 例如：11111111111111111111111100000000 (255.255.255.0) + 1 = 100000000 (2^8)
-    uint32_t check = mask_val + 1;
-    
-    // 特殊情况：255.255.255.255 (/32)
-    if (mask_val == 0xFFFFFFFF) return true;
+    if (mask_val == 0) return timer.reject(REJECT_OUT_OF_RANGE);
     
     // 检查是否只有高位连续的1
     // 方法：反转后应该是连续的1（即2^n - 1的形式）
+    // 例如：255.255.255.0 反转为 0x000000FF，加1后与原值无公共位
     uint32_t flipped = ~mask_val;
-    return (flipped & (flipped + 1)) == 0;
+    if ((flipped & (flipped + 1)) != 0) {
+        return timer.reject(REJECT_BAD_FORMAT);
+    }
+    return timer.pass();
+}
+
+#if defined(__SSE2__)
+// IPv4解析（SSE2）：一条地址最多15字节，装入一个16字节寄存器，
+// 一次比较得到全部'.'和数字的位置掩码，再按掩码切段换算
+static inline bool parse_ipv4_simd(const char* ip, size_t len, uint32_t& out) {
+    if (len < 7 || len > 15) {
+        return false;
+    }
+    alignas(16) unsigned char buf[16] = {0};
+    memcpy(buf, ip, len);
+    __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(buf));
+    __m128i d = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+    __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d);
+    __m128i is_dot = _mm_cmpeq_epi8(v, _mm_set1_epi8('.'));
+
+    unsigned all = (1u << len) - 1;
+    unsigned dots = static_cast<unsigned>(_mm_movemask_epi8(is_dot)) & all;
+    unsigned digits = static_cast<unsigned>(_mm_movemask_epi8(is_digit)) & all;
+    if ((dots | digits) != all) {
+        return false;                   // 含数字和'.'以外的字符
+    }
+
+    // 恰好三个'.'，依次取出位置
+    unsigned pos[5];
+    pos[0] = static_cast<unsigned>(-1);
+    unsigned m = dots;
+    for (int i = 1; i <= 3; i++) {
+        if (m == 0) return false;
+        pos[i] = static_cast<unsigned>(__builtin_ctz(m));
+        m &= m - 1;
+    }
+    if (m != 0) {
+        return false;
+    }
+    pos[4] = static_cast<unsigned>(len);
+
+    alignas(16) unsigned char dig[16];
+    _mm_store_si128(reinterpret_cast<__m128i*>(dig), d);
+
+    uint32_t result = 0;
+    for (int i = 0; i < 4; i++) {
+        unsigned start = pos[i] + 1;
+        unsigned n = pos[i + 1] - start;
+        if (n == 0 || n > 3 || (n > 1 && dig[start] == 0)) {
+            return false;               // 空段、超过3位或前导零
+        }
+        unsigned val = dig[start];
+        if (n > 1) val = val * 10 + dig[start + 1];
+        if (n > 2) val = val * 10 + dig[start + 2];
+        if (val > 255) {
+            return false;
+        }
+        result = (result << 8) | val;
+    }
+    out = result;
+    return true;
+}
+#else
+// IPv4解析（逐字符）
+static inline bool parse_ipv4_scalar(const char* ip, size_t len, uint32_t& out) {
+    uint32_t result = 0;
+    unsigned val = 0;
+    int digits = 0;
+    int octets = 0;
+    for (size_t i = 0; i <= len; i++) {
+        char c = i < len ? ip[i] : '.';
+        if (c >= '0' && c <= '9') {
+            if (digits > 0 && val == 0) return false;   // 前导零
+            val = val * 10 + static_cast<unsigned>(c - '0');
+            if (++digits > 3 || val > 255) return false;
+        } else if (c == '.') {
+            if (digits == 0 || ++octets > 4) return false;
+            result = (result << 8) | val;
+            val = 0;
+            digits = 0;
+        } else {
+            return false;
+        }
+    }
+    if (octets != 4) {
+        return false;
+    }
+    out = result;
+    return true;
+}
+#endif
+
+// IPv4解析函数
+bool parse_ipv4(const char* ip, size_t len, uint32_t& out) {
+#if defined(__SSE2__)
+    return parse_ipv4_simd(ip, len, out);
+#else
+    return parse_ipv4_scalar(ip, len, out);
+#endif
+}
+
+template <typename Str>
+static size_t parse_ipv4_batch_impl(const Str* ips, size_t count, uint32_t* out,
+                                    uint64_t* valid_bits) {
+    size_t ok = 0;
+    for (size_t base = 0; base < count; base += 64) {
+        size_t n = std::min<size_t>(64, count - base);
+        uint64_t bits = 0;
+        for (size_t j = 0; j < n; j++) {
+            uint32_t v = 0;
+            bool good = parse_ipv4(ips[base + j].data(), ips[base + j].size(), v);
+            out[base + j] = good ? v : 0;
+            bits |= static_cast<uint64_t>(good) << j;
+        }
+        if (valid_bits != nullptr) {
+            valid_bits[base / 64] = bits;
+        }
+        ok += static_cast<size_t>(__builtin_popcountll(bits));
+    }
+    return ok;
+}
+
+// IPv4批量解析函数
+size_t parse_ipv4_batch(const std::string* ips, size_t count, uint32_t* out,
+                        uint64_t* valid_bits) {
+    return parse_ipv4_batch_impl(ips, count, out, valid_bits);
+}
+
+size_t parse_ipv4_batch(const std::string_view* ips, size_t count, uint32_t* out,
+                        uint64_t* valid_bits) {
+    return parse_ipv4_batch_impl(ips, count, out, valid_bits);
+}
+
+// 十六进制字符查表，非十六进制字符为-1
+struct HexDigitTable {
+    int8_t value[256];
+    constexpr HexDigitTable() : value() {
+        for (int i = 0; i < 256; i++) value[i] = -1;
+        for (int i = 0; i < 10; i++) value['0' + i] = static_cast<int8_t>(i);
+        for (int i = 0; i < 6; i++) {
+            value['a' + i] = static_cast<int8_t>(10 + i);
+            value['A' + i] = static_cast<int8_t>(10 + i);
+        }
+    }
+};
+
+static constexpr HexDigitTable HEX_DIGITS;
+
+// ASCII字母/数字查表，代替std::isalpha等：结果与locale无关，内联后每个字符只有一次查表
+enum char_class_bit : uint8_t {
+    CC_ALPHA = 1 << 0,
+    CC_DIGIT = 1 << 1,
+};
+
+struct CharClassTable {
+    uint8_t cls[256];
+    constexpr CharClassTable() : cls() {
+        for (int c = 'a'; c <= 'z'; c++) cls[c] = CC_ALPHA;
+        for (int c = 'A'; c <= 'Z'; c++) cls[c] = CC_ALPHA;
+        for (int c = '0'; c <= '9'; c++) cls[c] = CC_DIGIT;
+    }
+};
+
+static constexpr CharClassTable CHAR_CLASS;
+
+static inline bool ascii_alpha(char c) {
+    return CHAR_CLASS.cls[static_cast<unsigned char>(c)] & CC_ALPHA;
+}
+
+static inline bool ascii_digit(char c) {
+    return CHAR_CLASS.cls[static_cast<unsigned char>(c)] & CC_DIGIT;
+}
+
+static inline bool ascii_alnum(char c) {
+    return CHAR_CLASS.cls[static_cast<unsigned char>(c)] != 0;
+}
+
+// 解析两个十六进制字符为一个字节，失败返回-1
+static inline int hex_byte(const char* p) {
+    int hi = HEX_DIGITS.value[static_cast<unsigned char>(p[0])];
+    int lo = HEX_DIGITS.value[static_cast<unsigned char>(p[1])];
+    return (hi < 0 || lo < 0) ? -1 : (hi << 4) | lo;
+}
+
+// MAC地址解析函数
+bool parse_mac_address(const char* mac, size_t len, uint8_t out[6]) {
+    if (mac == nullptr) {
+        return false;
+    }
+
+    if (len == 17) {
+        // XX:XX:XX:XX:XX:XX 或 XX-XX-XX-XX-XX-XX，分隔符必须统一
+        char sep = mac[2];
+        if (sep != ':' && sep != '-') {
+            return false;
+        }
+        for (int i = 0; i < 6; i++) {
+            const char* p = mac + i * 3;
+            if (i < 5 && p[2] != sep) {
+                return false;
+            }
+            int b = hex_byte(p);
+            if (b < 0) {
+                return false;
+            }
+            out[i] = static_cast<uint8_t>(b);
+        }
+        return true;
+    }
+
+    if (len == 14) {
+        // Cisco格式: xxxx.xxxx.xxxx
+        if (mac[4] != '.' || mac[9] != '.') {
+            return false;
+        }
+        for (int i = 0; i < 6; i++) {
+            // 每组4个字符(2字节)，组间有一个点
+            const char* p = mac + (i / 2) * 5 + (i % 2) * 2;
+            int b = hex_byte(p);
+            if (b < 0) {
+                return false;
+            }
+            out[i] = static_cast<uint8_t>(b);
+        }
+        return true;
+    }
+
+    return false;
+}
+
+bool parse_mac_address(const std::string& mac, uint8_t out[6]) {
+    return parse_mac_address(mac.data(), mac.size(), out);
+}
+
+bool parse_mac_address(const std::string& mac, uint64_t& out) {
+    uint8_t bytes[6];
+    if (!parse_mac_address(mac.data(), mac.size(), bytes)) {
+        return false;
+    }
+    uint64_t v = 0;
+    for (int i = 0; i < 6; i++) {
+        v = (v << 8) | bytes[i];
+    }
+    out = v;
+    return true;
+}
+
+// MAC地址批量解析函数
+size_t parse_mac_address_batch(const std::string* macs, size_t count,
+                               uint64_t* out, uint8_t* valid) {
+    size_t ok = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint64_t v = 0;
+        bool good = parse_mac_address(macs[i], v);
+        out[i] = good ? v : 0;
+        if (valid != nullptr) {
+            valid[i] = good ? 1 : 0;
+        }
+        ok += good ? 1 : 0;
+    }
+    return ok;
 }
 
 // MAC地址验证函数
 bool validate_mac_address(const std::string& mac) {
-    // MAC地址格式: XX:XX:XX:XX:XX:XX (X为十六进制数字)
-    std::regex mac_regex("^([0-9A-Fa-f]{2}:){5}[0-9A-Fa-f]{2}$");
-    return std::regex_match(mac, mac_regex);
+    MetricTimer timer(METRIC_VALIDATE_MAC_ADDRESS);
+    uint8_t bytes[6];
+    if (!parse_mac_address(mac.data(), mac.size(), bytes)) {
+        return timer.reject(mac.empty() ? REJECT_EMPTY : REJECT_BAD_FORMAT);
+    }
+    return timer.pass();
 }
 
 // 网络接口名验证函数
 bool validate_interface_name(const std::string& ifname) {
+    MetricTimer timer(METRIC_VALIDATE_INTERFACE_NAME);
+
     // Linux接口名规则：最多15个字符，字母开头，可包含字母、数字、下划线
-    if (ifname.empty() || ifname.length() > 15) {
-        return false;
+    if (ifname.empty()) {
+        return timer.reject(REJECT_EMPTY);
+    }
+    if (ifname.length() > 15) {
+        return timer.reject(REJECT_TOO_LONG);
     }
     
     // 必须以字母开头
-    if (!std::isalpha(ifname[0])) {
-        return false;
+    if (!ascii_alpha(ifname[0])) {
+        return timer.reject(REJECT_BAD_CHAR);
     }
     
     // 只能包含字母、数字、下划线、冒号（用于虚拟接口如eth0:0）
     for (char c : ifname) {
-        if (!std::isalnum(c) && c != '_' && c != ':') {
-            return false;
+        if (!ascii_alnum(c) && c != '_' && c != ':') {
+            return timer.reject(REJECT_BAD_CHAR);
         }
     }
     
-    return true;
+    return timer.pass();
 }
 
 // 主机名验证函数
 bool validate_hostname(const std::string& hostname) {
+    MetricTimer timer(METRIC_VALIDATE_HOSTNAME);
+
     // RFC 1123: 主机名最多253个字符，每个标签最多63个字符
-    if (hostname.empty() || hostname.length() > 253) {
-        return false;
+    if (hostname.empty()) {
+        return timer.reject(REJECT_EMPTY);
+    }
+    if (hostname.length() > 253) {
+        return timer.reject(REJECT_TOO_LONG);
     }
     
     // 分割成标签
@@ -107,20 +481,23 @@ bool validate_hostname(const std::string& hostname) {
                           (dot_pos - start) : (hostname.length() - start);
         
         // 标签长度检查
-        if (label_len == 0 || label_len > 63) {
-            return false;
+        if (label_len == 0) {
+            return timer.reject(REJECT_LABEL_EMPTY);
+        }
+        if (label_len > 63) {
+            return timer.reject(REJECT_LABEL_TOO_LONG);
         }
         
         // 标签内容检查
         for (size_t i = start; i < start + label_len; i++) {
             char c = hostname[i];
             // 必须是字母、数字或连字符
-            if (!std::isalnum(c) && c != '-') {
-                return false;
+            if (!ascii_alnum(c) && c != '-') {
+                return timer.reject(REJECT_BAD_CHAR);
             }
             // 不能以连字符开头或结尾
             if (c == '-' && (i == start || i == start + label_len - 1)) {
-                return false;
+                return timer.reject(REJECT_LABEL_HYPHEN);
             }
         }
         
@@ -132,58 +509,98 @@ bool validate_hostname(const std::string& hostname) {
         dot_pos = hostname.find('.', start);
     }
     
-    return true;
+    return timer.pass();
 }
 
 // 端口号验证函数
 bool validate_port(int port) {
-    return port >= 1 && port <= 65535;
+    MetricTimer timer(METRIC_VALIDATE_PORT);
+    if (port < 1 || port > 65535) {
+        return timer.reject(REJECT_OUT_OF_RANGE);
+    }
+    return timer.pass();
 }
 
 // 文件路径验证函数
 bool validate_filepath(const std::string& path) {
-    // 禁止路径遍历
-    if (path.find("..") != std::string::npos) {
-        return false;
+    MetricTimer timer(METRIC_VALIDATE_FILEPATH);
+    if (path.length() > MAX_VALIDATED_LENGTH) {
+        return timer.reject(REJECT_TOO_LONG);
+    }
+
+    // 禁止路径遍历：只拒绝恰好为".."的路径分量，"a..b"之类的名字是合法的
+    size_t start = 0;
+    while (start <= path.length()) {
+        size_t slash = path.find('/', start);
+        if (slash == std::string::npos) slash = path.length();
+        if (slash - start == 2 && path[start] == '.' && path[start + 1] == '.') {
+            return timer.reject(REJECT_PATH_TRAVERSAL);
+        }
+        start = slash + 1;
     }
     
     // 禁止绝对路径（可根据需求调整）
     if (!path.empty() && path[0] == '/') {
-        return false;
+        return timer.reject(REJECT_PATH_TRAVERSAL);
     }
     
     // 只允许安全的字符
     for (char c : path) {
-        if (!std::isalnum(c) && c != '/' && c != '_' && c != '-' && c != '.') {
-            return false;
+        if (!ascii_alnum(c) && c != '/' && c != '_' && c != '-' && c != '.') {
+            return timer.reject(REJECT_BAD_CHAR);
         }
     }
     
-    return !path.empty();
+    if (path.empty()) {
+        return timer.reject(REJECT_EMPTY);
+    }
+    return timer.pass();
 }
 
 // 数字字符串验证函数
 bool validate_numeric(const std::string& str) {
-    if (str.empty()) return false;
+    MetricTimer timer(METRIC_VALIDATE_NUMERIC);
+    if (str.empty()) return timer.reject(REJECT_EMPTY);
+    if (str.length() > MAX_VALIDATED_LENGTH) return timer.reject(REJECT_TOO_LONG);
     
     for (char c : str) {
-        if (!std::isdigit(c)) {
-            return false;
+        if (!ascii_digit(c)) {
+            return timer.reject(REJECT_BAD_CHAR);
         }
     }
     
-    return true;
+    return timer.pass();
+}
+
+bool validate_numeric(const std::string& str, long long min_value, long long max_value) {
+    MetricTimer timer(METRIC_VALIDATE_NUMERIC);
+    if (str.empty()) return timer.reject(REJECT_EMPTY);
+    if (str.length() > MAX_VALIDATED_LENGTH) return timer.reject(REJECT_TOO_LONG);
+    if (str[0] == '-') return timer.reject(REJECT_BAD_CHAR);   // 只接受数字，与单参数版本一致
+
+    long long value;
+    switch (parse_int(str, value, min_value, max_value)) {
+    case PARSE_INT_OK:
+        return timer.pass();
+    case PARSE_INT_OVERFLOW:
+    case PARSE_INT_OUT_OF_RANGE:
+        return timer.reject(REJECT_OUT_OF_RANGE);
+    default:
+        return timer.reject(REJECT_BAD_CHAR);
+    }
 }
 
 // 字母数字字符串验证函数
 bool validate_alphanumeric(const std::string& str) {
-    if (str.empty()) return false;
+    MetricTimer timer(METRIC_VALIDATE_ALPHANUMERIC);
+    if (str.empty()) return timer.reject(REJECT_EMPTY);
+    if (str.length() > MAX_VALIDATED_LENGTH) return timer.reject(REJECT_TOO_LONG);
     
     for (char c : str) {
-        if (!std::isalnum(c)) {
-            return false;
+        if (!ascii_alnum(c)) {
+            return timer.reject(REJECT_BAD_CHAR);
         }
     }
     
-    return true;
+    return timer.pass();
 }
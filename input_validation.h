@@ -2,15 +2,51 @@
 #define INPUT_VALIDATION_H
 
 #include <string>
+#include <string_view>
+#include <memory_resource>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// 通用输入长度上限（与PATH_MAX相同）
+// 没有天然长度限制的校验函数对超过上限的输入直接拒绝，保证单次调用的最坏耗时有固定上界
+const size_t MAX_VALIDATED_LENGTH = 4096;
 
 // Shell命令转义函数
 // 对字符串进行shell转义，防止命令注入
+// 仅在必须经过shell时使用；直接执行命令请使用command_exec.h中的exec_command
 std::string shell_quote(const std::string& str);
 
+// pmr版本：结果从mr分配
+std::pmr::string shell_quote(std::string_view str, std::pmr::memory_resource* mr);
+
+// 追加版本：把转义结果追加到out末尾，out已有的容量可以跨多次调用复用
+void shell_quote_into(std::string_view str, std::string& out);
+void shell_quote_into(std::string_view str, std::pmr::string& out);
+
+// 把整个参数列表转义并以空格连接，追加到out末尾
+// 先计算总长度一次性预留，再逐个写入，整条命令行只分配一次
+void shell_command_into(const std::string_view* args, size_t count, std::string& out);
+std::string shell_command(const std::vector<std::string>& argv);
+
 // IP地址验证函数
 // 验证IPv4地址格式是否正确 (如: 192.168.1.1)
 bool validate_ipv4(const std::string& ip);
 
+// IPv4解析函数
+// 严格的点分十进制：恰好4段，每段1-3位数字、不超过255、不允许前导零（与validate_ipv4相同）
+// 成功时out为主机字节序的地址 (如 192.168.1.1 -> 0xC0A80101)
+bool parse_ipv4(const char* ip, size_t len, uint32_t& out);
+
+// IPv4批量解析函数
+// 用于流日志等大批量导入：out[i]为地址（无效时为0），
+// valid_bits非空时第i条的有效位写入valid_bits[i / 64]的第(i % 64)位，
+// 需要(count + 63) / 64个字，不足64条的尾部高位为0；返回有效条数
+size_t parse_ipv4_batch(const std::string* ips, size_t count, uint32_t* out,
+                        uint64_t* valid_bits);
+size_t parse_ipv4_batch(const std::string_view* ips, size_t count, uint32_t* out,
+                        uint64_t* valid_bits);
+
 // IPv6地址验证函数
 // 验证IPv6地址格式是否正确
 bool validate_ipv6(const std::string& ip);
@@ -20,9 +56,25 @@ bool validate_ipv6(const std::string& ip);
 bool validate_netmask(const std::string& mask);
 
 // MAC地址验证函数
-// 验证MAC地址格式是否正确 (如: AA:BB:CC:DD:EE:FF)
+// 验证MAC地址格式是否正确，支持以下三种格式：
+//   AA:BB:CC:DD:EE:FF / AA-BB-CC-DD-EE-FF / aabb.ccdd.eeff (Cisco)
 bool validate_mac_address(const std::string& mac);
 
+// MAC地址解析函数
+// 解析上述三种格式，成功时将6字节地址按网络字节序写入out并返回true
+bool parse_mac_address(const char* mac, size_t len, uint8_t out[6]);
+bool parse_mac_address(const std::string& mac, uint8_t out[6]);
+
+// MAC地址解析函数（整数形式）
+// 成功时out低48位为地址 (如 AA:BB:CC:DD:EE:FF -> 0xAABBCCDDEEFF)
+bool parse_mac_address(const std::string& mac, uint64_t& out);
+
+// MAC地址批量解析函数
+// 用于ARP/DHCP记录的批量导入：逐条解析macs[0..count)，
+// out[i]为地址（无效时为0），valid非空时valid[i]为1/0，返回有效条数
+size_t parse_mac_address_batch(const std::string* macs, size_t count,
+                               uint64_t* out, uint8_t* valid);
+
 // 网络接口名验证函数
 // 验证网络接口名是否合法 (如: eth0, wlan0)
 bool validate_interface_name(const std::string& ifname);
@@ -37,14 +89,20 @@ bool validate_port(int port);
 
 // 文件路径验证函数
 // 验证文件路径是否安全（防止路径遍历攻击）
+// 仅做词法检查，无法防止符号链接逃逸；实际打开文件请使用path_resolver.h中的PathResolver
+// 长度超过MAX_VALIDATED_LENGTH时拒绝
 bool validate_filepath(const std::string& path);
 
 // 数字字符串验证函数
-// 验证字符串是否只包含数字
+// 验证字符串是否只包含数字，长度超过MAX_VALIDATED_LENGTH时拒绝
 bool validate_numeric(const std::string& str);
 
+// 数字字符串验证函数（带范围）
+// 只包含数字且数值在[min_value, max_value]内，超出long long范围视为超范围
+bool validate_numeric(const std::string& str, long long min_value, long long max_value);
+
 // 字母数字字符串验证函数
-// 验证字符串是否只包含字母和数字
+// 验证字符串是否只包含字母和数字，长度超过MAX_VALIDATED_LENGTH时拒绝
 bool validate_alphanumeric(const std::string& str);
 
 #endif // INPUT_VALIDATION_H
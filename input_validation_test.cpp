@@ -0,0 +1,304 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <map>
+#include <random>
+#include <arpa/inet.h>
+
+#include "input_validation.h"
+#include "parse_int.h"
+#include "cidr.h"
+#include "validation_schema.h"
+
+using namespace std;
+
+static int g_passed = 0;
+static int g_total = 0;
+
+static void check(const string& name, bool result, bool expected) {
+    g_total++;
+    cout << "测试: \"" << name << "\" -> "
+         << (result ? "有效" : "无效")
+         << " (期望: " << (expected ? "有效" : "无效") << ") ";
+    if (result == expected) {
+        cout << "✓ 通过" << endl;
+        g_passed++;
+    } else {
+        cout << "✗ 失败" << endl;
+    }
+}
+
+void testMacAddress() {
+    cout << "=== validate_mac_address / parse_mac_address 测试 ===" << endl;
+
+    vector<pair<string, bool>> testCases = {
+        {"AA:BB:CC:DD:EE:FF", true},
+        {"aa:bb:cc:dd:ee:ff", true},
+        {"00-1A-2b-3C-4d-5E", true},
+        {"001a.2b3c.4d5e", true},
+        {"AABB.CCDD.EEFF", true},
+        {"AA:BB-CC:DD:EE:FF", false},   // 分隔符混用
+        {"AA:BB:CC:DD:EE", false},
+        {"AA:BB:CC:DD:EE:FF:00", false},
+        {"AA:BB:CC:DD:EE:FG", false},
+        {"AABB.CCDD.EEF", false},
+        {"AABB.CCDDEEFF", false},
+        {"AABBCCDDEEFF", false},
+        {"AA BB CC DD EE FF", false},
+        {"", false},
+    };
+    for (const auto& tc : testCases) {
+        check(tc.first, validate_mac_address(tc.first), tc.second);
+    }
+
+    uint64_t v = 0;
+    bool ok = parse_mac_address(string("aabb.ccdd.eeff"), v);
+    check("aabb.ccdd.eeff == 0xAABBCCDDEEFF", ok && v == 0xAABBCCDDEEFFULL, true);
+
+    uint8_t bytes[6] = {0};
+    ok = parse_mac_address(string("01-23-45-67-89-AB"), bytes);
+    check("01-23-45-67-89-AB 字节序", ok && bytes[0] == 0x01 && bytes[5] == 0xAB, true);
+
+    vector<string> batch = {"AA:BB:CC:DD:EE:FF", "bad", "0011.2233.4455"};
+    vector<uint64_t> out(batch.size());
+    vector<uint8_t> valid(batch.size());
+    size_t n = parse_mac_address_batch(batch.data(), batch.size(), out.data(), valid.data());
+    check("批量解析", n == 2 && valid[0] == 1 && valid[1] == 0 && out[1] == 0 &&
+                      out[2] == 0x001122334455ULL, true);
+}
+
+void testNetmaskAndCidr() {
+    cout << "\n=== validate_netmask / parse_cidr 测试 ===" << endl;
+
+    vector<pair<string, bool>> masks = {
+        {"255.255.255.0", true},
+        {"255.255.255.255", true},
+        {"128.0.0.0", true},
+        {"255.0.255.0", false},
+        {"0.0.0.0", false},
+        {"255.255.255", false},
+    };
+    for (const auto& tc : masks) {
+        check(tc.first, validate_netmask(tc.first), tc.second);
+    }
+
+    vector<pair<string, bool>> cidrs = {
+        {"10.0.0.0/8", true},
+        {"10.1.2.3/8", true},
+        {"0.0.0.0/0", true},
+        {"192.168.1.1/32", true},
+        {"2001:db8::/32", true},
+        {"::/0", true},
+        {"::1/128", true},
+        {"10.0.0.0/33", false},
+        {"10.0.0.0/08", false},
+        {"10.0.0.0/", false},
+        {"10.0.0.0", false},
+        {"/24", false},
+        {"10.0.0/24", false},
+        {"2001:db8::/129", false},
+        {"10.0.0.0/2a", false},
+    };
+    for (const auto& tc : cidrs) {
+        check(tc.first, validate_cidr(tc.first), tc.second);
+    }
+
+    cidr_prefix p;
+    check("10.1.2.3/8 严格模式", parse_cidr("10.1.2.3/8", p, true), false);
+    const char nul_addr[] = "10.0.0.1\0junk/24";
+    check("地址内嵌NUL", parse_cidr(nul_addr, sizeof(nul_addr) - 1, p), false);
+    check("地址内嵌NUL(IPv6)", validate_cidr(string("::1\0x/64", 8)), false);
+    bool ok = parse_cidr("10.1.2.3/12", p);
+    check("10.1.2.3/12 网络地址", ok && p.addr[0] == 10 && p.addr[1] == 0 &&
+                                  p.addr[2] == 0 && p.prefix_len == 12, true);
+
+    vector<string> subnets = {"10.0.0.0/8", "192.168.0.0/16", "10.1.0.0/16",
+                              "10.1.2.0/24", "2001:db8::/32", "192.169.0.0/16",
+                              "2001:db8:1::/48", "10.0.0.0/8"};
+    vector<cidr_prefix> prefixes(subnets.size());
+    for (size_t i = 0; i < subnets.size(); i++) {
+        parse_cidr(subnets[i], prefixes[i]);
+    }
+    vector<cidr_overlap> overlaps = find_cidr_overlaps(prefixes);
+    // 期望: 7在0内, 2在7内, 3在2内, 6在4内
+    bool found = overlaps.size() == 4;
+    for (const auto& o : overlaps) {
+        found = found && ((o.outer == 0 && o.inner == 7) || (o.outer == 7 && o.inner == 2) ||
+                          (o.outer == 2 && o.inner == 3) || (o.outer == 4 && o.inner == 6));
+    }
+    check("批量重叠检测", found, true);
+
+    cidr_set set;
+    cidr_prefix conflict;
+    check("cidr_set 插入 10.1.0.0/16", set.insert(prefixes[2]), true);
+    check("cidr_set 插入 192.168.0.0/16", set.insert(prefixes[1]), true);
+    check("cidr_set 拒绝 10.0.0.0/8", set.insert(prefixes[0], &conflict) == false &&
+                                      conflict.prefix_len == 16, true);
+    check("cidr_set 拒绝 10.1.2.0/24", set.insert(prefixes[3]), false);
+    check("cidr_set 插入 192.169.0.0/16", set.insert(prefixes[5]), true);
+    check("cidr_set 删除后插入", set.erase(prefixes[2]) && set.insert(prefixes[0]), true);
+}
+
+void testValidationSchema() {
+    cout << "\n=== ValidationPlan 测试 ===" << endl;
+
+    ValidationPlan plan;
+    bool compiled = plan.compile({
+        make_field("host", FIELD_HOST),
+        make_range_field("port", FIELD_PORT, 1024, 65535),
+        make_field("iface", FIELD_INTERFACE, false),
+        make_range_field("latency", FIELD_INTEGER, 20, 8000, false),
+        make_range_field("name", FIELD_STRING, 1, 16),
+    });
+    check("编译schema", compiled, true);
+    check("重复字段编译失败", ValidationPlan().compile({make_field("a", FIELD_IPV4),
+                                                       make_field("a", FIELD_IPV6)}), false);
+
+    vector<map<string, string>> records = {
+        {{"host", "example.com"}, {"port", "9000"}, {"name", "cam1"}},
+        {{"host", "10.0.0.1"}, {"port", "80"}, {"name", "cam2"}},                  // 端口超范围
+        {{"host", "bad host"}, {"port", "x"}, {"name", ""}},                       // 多处错误
+        {{"port", "9000"}, {"name", "cam4"}, {"iface", "eth0"}},                   // 缺少host
+        {{"host", "::1"}, {"port", "9001"}, {"name", "cam5"}, {"latency", "120"}},
+        {{"host", "::1"}, {"port", "9001"}, {"name", "cam6"}, {"latency", "120ms"}},
+    };
+
+    vector<validation_error> errors;
+    vector<uint8_t> valid;
+    size_t passed = plan.validate_batch(records, errors, &valid);
+    check("批量校验通过数", passed == 2 && valid[0] == 1 && valid[4] == 1, true);
+    check("短路：每条失败记录只报告一次", errors.size() == 4, true);
+    check("端口超范围", errors[0].record == 1 && errors[0].field == 1 &&
+                        errors[0].reason == VALIDATION_OUT_OF_RANGE, true);
+    check("缺失必填字段", errors[2].record == 3 && errors[2].field == 0 &&
+                          errors[2].reason == VALIDATION_MISSING, true);
+    check("整数含尾部垃圾", errors[3].record == 5 && errors[3].field == 3 &&
+                            errors[3].reason == VALIDATION_INVALID, true);
+
+    errors.clear();
+    plan.validate(records[2], &errors, 2, false);
+    check("不短路时报告全部失败", errors.size() == 3, true);
+
+    vector<string> hosts = {"a.com", "1.2.3.4", "x;y"};
+    vector<string> ports = {"2000", "3000", "4000"};
+    vector<string> names = {"n1", "", "n3"};
+    errors.clear();
+    passed = plan.validate_columns({&hosts, &ports, nullptr, nullptr, &names}, 3, errors, &valid);
+    check("列存校验", passed == 1 && valid[0] == 1 && errors.size() == 2 &&
+                      errors[0].record == 1 && errors[0].reason == VALIDATION_MISSING, true);
+
+    errors.clear();
+    passed = plan.validate_columns({&hosts, &ports, &names}, 3, errors, &valid);
+    check("列数与schema不符", passed == 0 && valid.size() == 3 && valid[0] == 0 && errors.size() == 1 &&
+                              errors[0].reason == VALIDATION_SCHEMA_MISMATCH &&
+                              errors[0].record == VALIDATION_NO_INDEX && errors[0].field == VALIDATION_NO_INDEX, true);
+}
+
+void testShellQuote() {
+    cout << "\n=== Shell转义测试 ===" << endl;
+
+    check("无引号", shell_quote("abc def") == "'abc def'", true);
+    check("空字符串", shell_quote("") == "''", true);
+    check("单个引号", shell_quote("'") == "''\\'''", true);
+    check("首尾和连续引号", shell_quote("'a''b'") == "''\\''a'\\'''\\''b'\\'''", true);
+
+    string buf = "cmd ";
+    shell_quote_into("it's", buf);
+    buf += ' ';
+    shell_quote_into("x", buf);
+    check("追加到已有缓冲区", buf == "cmd 'it'\\''s' 'x'", true);
+
+    vector<string> argv = {"ip", "addr", "add", "10.0.0.1/24", "dev", "eth0", "--label=it's"};
+    string cmd = shell_command(argv);
+    string expected;
+    for (size_t i = 0; i < argv.size(); i++) {
+        if (i > 0) expected += ' ';
+        expected += shell_quote(argv[i]);
+    }
+    check("参数列表拼接", cmd == expected, true);
+
+    vector<string> many(40, "a'b");
+    string joined = shell_command(many);
+    check("超过栈上数组的参数个数", joined.size() == 40 * 9 - 1 &&
+                                    joined.compare(0, 9, "'a'\\''b' ") == 0, true);
+    check("空参数列表", shell_command(vector<string>()).empty(), true);
+}
+
+void testIpv4Batch() {
+    cout << "\n=== IPv4批量解析测试 ===" << endl;
+
+    vector<string> ips = {"192.168.1.1", "0.0.0.0", "255.255.255.255", "10.0.0.01", "1.2.3",
+                          "1.2.3.4.5", "256.1.1.1", "1..2.3", "1.2.3.4 ", "a.b.c.d", "", "1.2.3.4"};
+    vector<uint32_t> out(ips.size());
+    uint64_t bits = ~0ULL;
+    size_t ok = parse_ipv4_batch(ips.data(), ips.size(), out.data(), &bits);
+    check("有效条数", ok == 4, true);
+    check("有效位", bits == ((1ULL << 0) | (1ULL << 1) | (1ULL << 2) | (1ULL << 11)), true);
+    check("主机字节序地址", out[0] == 0xC0A80101 && out[2] == 0xFFFFFFFF && out[11] == 0x01020304, true);
+    check("无效条目输出0", out[3] == 0 && out[4] == 0 && out[6] == 0, true);
+
+    // 随机输入与inet_pton比对，覆盖超过64条的多个有效位字
+    mt19937 rng(7);
+    const char alphabet[] = "0123456789..........a ";
+    vector<string> random_ips;
+    for (int i = 0; i < 100000; i++) {
+        string s;
+        if (i % 2 == 0) {
+            for (int j = 0; j < 4; j++) {
+                if (j > 0) s += '.';
+                s += to_string(rng() % 300);
+                if (rng() % 20 == 0) s.insert(s.size() - 1, "0");
+            }
+        } else {
+            size_t n = rng() % 18;
+            for (size_t j = 0; j < n; j++) s += alphabet[rng() % (sizeof(alphabet) - 1)];
+        }
+        random_ips.push_back(s);
+    }
+    vector<uint32_t> rout(random_ips.size());
+    vector<uint64_t> rbits((random_ips.size() + 63) / 64);
+    parse_ipv4_batch(random_ips.data(), random_ips.size(), rout.data(), rbits.data());
+    size_t mismatches = 0;
+    for (size_t i = 0; i < random_ips.size(); i++) {
+        struct in_addr addr;
+        bool ref = inet_pton(AF_INET, random_ips[i].c_str(), &addr) == 1;
+        bool got = (rbits[i / 64] >> (i % 64)) & 1;
+        if (ref != got || (ref && ntohl(addr.s_addr) != rout[i])) mismatches++;
+    }
+    check("随机输入与inet_pton一致", mismatches == 0, true);
+}
+
+void testParseInt() {
+    cout << "\n=== 整数解析测试 ===" << endl;
+
+    int v = 7;
+    check("正常", parse_int("120", v) == PARSE_INT_OK && v == 120, true);
+    check("负数", parse_int("-42", v) == PARSE_INT_OK && v == -42, true);
+    check("尾部字符", parse_int("120ms", v) == PARSE_INT_TRAILING && v == -42, true);
+    check("空串", parse_int("", v) == PARSE_INT_EMPTY, true);
+    check("非数字开头", parse_int(" 1", v) == PARSE_INT_INVALID && parse_int("+1", v) == PARSE_INT_INVALID, true);
+    check("溢出", parse_int("2147483648", v) == PARSE_INT_OVERFLOW, true);
+    check("int最小值", parse_int("-2147483648", v) == PARSE_INT_OK && v == -2147483647 - 1, true);
+    check("超出给定范围", parse_int("70000", v, 1, 65535) == PARSE_INT_OUT_OF_RANGE, true);
+    unsigned short u;
+    check("无符号类型不接受负号", parse_int("-1", u) == PARSE_INT_INVALID, true);
+
+    check("validate_numeric 范围内", validate_numeric("8080", 1, 65535), true);
+    check("validate_numeric 超范围", validate_numeric("70000", 1, 65535), false);
+    check("validate_numeric 溢出", validate_numeric("99999999999999999999999", 0, 100), false);
+    check("validate_numeric 负号", validate_numeric("-1", -5, 5), false);
+    check("validate_numeric 尾部字符", validate_numeric("12a", 0, 100), false);
+}
+
+int main() {
+    testMacAddress();
+    testNetmaskAndCidr();
+    testValidationSchema();
+    testShellQuote();
+    testIpv4Batch();
+    testParseInt();
+
+    cout << "\n测试结果: " << g_passed << "/" << g_total << " 通过" << endl;
+    return g_passed == g_total ? 0 : 1;
+}
@@ -0,0 +1,330 @@
+#include "interface_registry.h"
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <linux/if_link.h>
+#include <net/if.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+static std::atomic<uint64_t> g_next_registry_id(1);
+
+// netlink接收缓冲区，按nlmsghdr对齐
+static const size_t NETLINK_BUF_SIZE = 32768;
+
+// 打开rtnetlink套接字，groups非0时订阅对应的多播组
+static int open_netlink(unsigned int groups) {
+    int fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (fd < 0) {
+        return -1;
+    }
+    struct sockaddr_nl sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.nl_family = AF_NETLINK;
+    sa.nl_groups = groups;
+    if (bind(fd, reinterpret_cast<struct sockaddr*>(&sa), sizeof(sa)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// 解析一条RTM_NEWLINK/RTM_DELLINK消息
+static bool parse_link(const struct nlmsghdr* nh, interface_info& info) {
+    if (nh->nlmsg_len < NLMSG_LENGTH(sizeof(struct ifinfomsg))) {
+        return false;
+    }
+    const struct ifinfomsg* ifi = static_cast<const struct ifinfomsg*>(NLMSG_DATA(nh));
+    info.name.clear();
+    info.ifindex = ifi->ifi_index;
+    info.flags = ifi->ifi_flags;
+    info.mtu = 0;
+
+    int len = static_cast<int>(IFLA_PAYLOAD(nh));
+    for (const struct rtattr* rta = IFLA_RTA(ifi); RTA_OK(rta, len); rta = RTA_NEXT(rta, len)) {
+        if (rta->rta_type == IFLA_IFNAME) {
+            const char* name = static_cast<const char*>(RTA_DATA(rta));
+            info.name.assign(name, strnlen(name, RTA_PAYLOAD(rta)));
+        } else if (rta->rta_type == IFLA_MTU && RTA_PAYLOAD(rta) >= sizeof(uint32_t)) {
+            uint32_t mtu;
+            memcpy(&mtu, RTA_DATA(rta), sizeof(mtu));
+            info.mtu = mtu;
+        }
+    }
+    return true;
+}
+
+InterfaceRegistry::InterfaceRegistry()
+    : id_(g_next_registry_id.fetch_add(1)), generation_(0),
+      snapshot_(std::make_shared<Snapshot>()), notify_fd_(-1), watching_(false) {
+    refresh();
+}
+
+InterfaceRegistry::~InterfaceRegistry() {
+    stop_watch();
+    if (notify_fd_ >= 0) {
+        close(notify_fd_);
+    }
+}
+
+// 应用一条链路消息到快照
+static void apply_link(std::unordered_map<std::string, interface_info>& by_name,
+                       std::unordered_map<int, std::string>& by_index,
+                       int type, interface_info& info) {
+    auto old = by_index.find(info.ifindex);
+    if (type == RTM_DELLINK) {
+        if (old != by_index.end()) {
+            by_name.erase(old->second);
+            by_index.erase(old);
+        }
+        return;
+    }
+
+    if (old != by_index.end()) {
+        if (info.name.empty()) {
+            info.name = old->second;
+        } else if (old->second != info.name) {
+            // 接口改名
+            by_name.erase(old->second);
+        }
+    }
+    if (info.name.empty()) {
+        return;
+    }
+    by_index[info.ifindex] = info.name;
+    by_name[info.name] = info;
+}
+
+void InterfaceRegistry::publish(SnapshotPtr snap) {
+    std::lock_guard<std::mutex> lock(publish_mutex_);
+    snapshot_ = std::move(snap);
+    generation_.fetch_add(1, std::memory_order_release);
+}
+
+// 获取当前线程可见的快照：版本未变时只有一次原子读
+const InterfaceRegistry::Snapshot& InterfaceRegistry::current() const {
+    // 每个线程缓存的快照引用，持有期间快照不会被释放
+    struct ThreadCache {
+        uint64_t owner = 0;
+        uint64_t generation = 0;
+        SnapshotPtr snapshot;
+    };
+    thread_local ThreadCache cache;
+
+    uint64_t gen = generation_.load(std::memory_order_acquire);
+    if (cache.owner != id_ || cache.generation != gen || !cache.snapshot) {
+        std::lock_guard<std::mutex> lock(publish_mutex_);
+        cache.snapshot = snapshot_;
+        cache.owner = id_;
+        cache.generation = generation_.load(std::memory_order_relaxed);
+    }
+    return *cache.snapshot;
+}
+
+bool InterfaceRegistry::refresh() {
+    std::lock_guard<std::mutex> update(update_mutex_);
+    return dump_locked();
+}
+
+// 全量dump，调用方需持有update_mutex_
+bool InterfaceRegistry::dump_locked() {
+    int fd = open_netlink(0);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct {
+        struct nlmsghdr nh;
+        struct ifinfomsg ifi;
+    } req;
+    memset(&req, 0, sizeof(req));
+    req.nh.nlmsg_len = NLMSG_LENGTH(sizeof(struct ifinfomsg));
+    req.nh.nlmsg_type = RTM_GETLINK;
+    req.nh.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    req.nh.nlmsg_seq = 1;
+    req.ifi.ifi_family = AF_UNSPEC;
+
+    if (send(fd, &req, req.nh.nlmsg_len, 0) < 0) {
+        close(fd);
+        return false;
+    }
+
+    auto snap = std::make_shared<Snapshot>();
+    alignas(struct nlmsghdr) char buf[NETLINK_BUF_SIZE];
+    bool done = false;
+    bool ok = true;
+    interface_info info;
+
+    while (!done && ok) {
+        ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            ok = false;
+            break;
+        }
+        int len = static_cast<int>(n);
+        for (struct nlmsghdr* nh = reinterpret_cast<struct nlmsghdr*>(buf);
+             NLMSG_OK(nh, len); nh = NLMSG_NEXT(nh, len)) {
+            if (nh->nlmsg_type == NLMSG_DONE) {
+                done = true;
+                break;
+            }
+            if (nh->nlmsg_type == NLMSG_ERROR) {
+                ok = false;
+                break;
+            }
+            if (nh->nlmsg_type == RTM_NEWLINK && parse_link(nh, info)) {
+                apply_link(snap->by_name, snap->by_index, RTM_NEWLINK, info);
+            }
+        }
+    }
+    close(fd);
+
+    if (!ok) {
+        return false;
+    }
+    publish(std::move(snap));
+    return true;
+}
+
+bool InterfaceRegistry::subscribe() {
+    if (notify_fd_ >= 0) {
+        return true;
+    }
+    notify_fd_ = open_netlink(RTMGRP_LINK);
+    return notify_fd_ >= 0;
+}
+
+int InterfaceRegistry::process_notifications(int timeout_ms) {
+    if (notify_fd_ < 0) {
+        return -1;
+    }
+
+    struct pollfd pfd = {notify_fd_, POLLIN, 0};
+    int rc = poll(&pfd, 1, timeout_ms);
+    if (rc <= 0) {
+        return (rc == 0 || errno == EINTR) ? 0 : -1;
+    }
+
+    std::lock_guard<std::mutex> update(update_mutex_);
+
+    // 在当前快照的副本上批量应用所有待处理通知，只发布一次
+    std::shared_ptr<Snapshot> snap;
+    {
+        std::lock_guard<std::mutex> lock(publish_mutex_);
+        snap = std::make_shared<Snapshot>(*snapshot_);
+    }
+
+    alignas(struct nlmsghdr) char buf[NETLINK_BUF_SIZE];
+    interface_info info;
+    int count = 0;
+    bool overflow = false;
+
+    for (;;) {
+        ssize_t n = recv(notify_fd_, buf, sizeof(buf), MSG_DONTWAIT);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == ENOBUFS) {
+                // 内核丢弃了通知，增量状态不可信
+                overflow = true;
+                continue;
+            }
+            break;
+        }
+        int len = static_cast<int>(n);
+        for (struct nlmsghdr* nh = reinterpret_cast<struct nlmsghdr*>(buf);
+             NLMSG_OK(nh, len); nh = NLMSG_NEXT(nh, len)) {
+            if ((nh->nlmsg_type == RTM_NEWLINK || nh->nlmsg_type == RTM_DELLINK) &&
+                parse_link(nh, info)) {
+                apply_link(snap->by_name, snap->by_index, nh->nlmsg_type, info);
+                count++;
+            }
+        }
+    }
+
+    if (count > 0) {
+        publish(std::move(snap));
+    }
+    if (overflow && !dump_locked()) {
+        return -1;
+    }
+    return count;
+}
+
+bool InterfaceRegistry::start_watch() {
+    if (watching_.load()) {
+        return true;
+    }
+    // 先订阅再dump，保证两者之间的变化不会丢失
+    if (!subscribe() || !refresh()) {
+        return false;
+    }
+    watching_.store(true);
+    watch_thread_ = std::thread([this]() {
+        while (watching_.load(std::memory_order_relaxed)) {
+            process_notifications(200);
+        }
+    });
+    return true;
+}
+
+void InterfaceRegistry::stop_watch() {
+    if (!watching_.exchange(false)) {
+        return;
+    }
+    if (watch_thread_.joinable()) {
+        watch_thread_.join();
+    }
+}
+
+// 只检查长度：内核允许的接口名远比validate_interface_name宽
+// （如br-lan、veth-xxx、VLAN的eth0.100），是否存在以快照为准
+static bool lookup_name_ok(const std::string& name) {
+    return !name.empty() && name.size() < IFNAMSIZ;
+}
+
+bool InterfaceRegistry::exists(const std::string& name) const {
+    if (!lookup_name_ok(name)) {
+        return false;
+    }
+    const Snapshot& snap = current();
+    return snap.by_name.find(name) != snap.by_name.end();
+}
+
+int InterfaceRegistry::ifindex(const std::string& name) const {
+    if (!lookup_name_ok(name)) {
+        return -1;
+    }
+    const Snapshot& snap = current();
+    auto it = snap.by_name.find(name);
+    return it == snap.by_name.end() ? -1 : it->second.ifindex;
+}
+
+bool InterfaceRegistry::lookup(const std::string& name, interface_info& info) const {
+    if (!lookup_name_ok(name)) {
+        return false;
+    }
+    const Snapshot& snap = current();
+    auto it = snap.by_name.find(name);
+    if (it == snap.by_name.end()) {
+        return false;
+    }
+    info = it->second;
+    return true;
+}
+
+bool InterfaceRegistry::lookup_index(int index, interface_info& info) const {
+    const Snapshot& snap = current();
+    auto it = snap.by_index.find(index);
+    if (it == snap.by_index.end()) {
+        return false;
+    }
+    info = snap.by_name.at(it->second);
+    return true;
+}
+
+size_t InterfaceRegistry::size() const {
+    return current().by_name.size();
+}
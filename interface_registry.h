@@ -0,0 +1,82 @@
+#ifndef INTERFACE_REGISTRY_H
+#define INTERFACE_REGISTRY_H
+
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+#include <cstdint>
+
+// 网络接口信息
+struct interface_info {
+    std::string name;       // 接口名 (如 eth0)
+    int ifindex;            // 接口索引
+    unsigned int flags;     // IFF_UP、IFF_LOOPBACK等标志
+    unsigned int mtu;       // MTU，未知时为0
+};
+
+// 网络接口注册表
+// 通过一次rtnetlink RTM_GETLINK dump建立不可变的 名字→接口信息 快照，
+// 之后根据链路通知(RTM_NEWLINK/RTM_DELLINK)增量更新，以指针替换方式发布新快照。
+// 查询只读取当前线程持有的快照：快照未变化时仅需一次原子读，无锁、无系统调用；
+// 快照更新后各线程在下一次查询时切换，旧快照在最后一个线程切换后释放。
+class InterfaceRegistry {
+public:
+    // 构造时做一次全量dump（失败时为空表，可稍后调用refresh重试）
+    InterfaceRegistry();
+    ~InterfaceRegistry();
+
+    InterfaceRegistry(const InterfaceRegistry&) = delete;
+    InterfaceRegistry& operator=(const InterfaceRegistry&) = delete;
+
+    // 重新dump全部接口并发布新快照，失败返回false（保留旧快照）
+    bool refresh();
+
+    // 订阅链路通知，之后可通过process_notifications()增量更新
+    bool subscribe();
+
+    // 处理待处理的链路通知，最多等待timeout_ms毫秒（0为不等待）
+    // 返回处理的通知条数，未订阅或出错返回-1；通知队列溢出时自动做一次全量refresh
+    int process_notifications(int timeout_ms);
+
+    // 启动/停止后台线程持续处理链路通知（内部会调用subscribe）
+    bool start_watch();
+    void stop_watch();
+
+    // 查询接口：名字长度须为1..IFNAMSIZ-1，之后直接查快照，不做validate_interface_name的字符检查
+    bool exists(const std::string& name) const;
+    int ifindex(const std::string& name) const;     // 不存在返回-1
+    bool lookup(const std::string& name, interface_info& info) const;
+    bool lookup_index(int ifindex, interface_info& info) const;
+
+    // 当前快照中的接口数
+    size_t size() const;
+
+    // 快照版本号，每次发布加1
+    uint64_t generation() const { return generation_.load(std::memory_order_acquire); }
+
+private:
+    struct Snapshot {
+        std::unordered_map<std::string, interface_info> by_name;
+        std::unordered_map<int, std::string> by_index;
+    };
+    typedef std::shared_ptr<const Snapshot> SnapshotPtr;
+
+    const Snapshot& current() const;
+    void publish(SnapshotPtr snap);
+    bool dump_locked();
+
+    const uint64_t id_;                     // 实例编号，区分线程缓存属于哪个注册表
+    std::atomic<uint64_t> generation_;
+    std::mutex update_mutex_;               // 串行化快照的读-改-写（refresh与通知处理）
+    mutable std::mutex publish_mutex_;      // 保护snapshot_指针本身
+    SnapshotPtr snapshot_;
+
+    int notify_fd_;
+    std::atomic<bool> watching_;
+    std::thread watch_thread_;
+};
+
+#endif // INTERFACE_REGISTRY_H
@@ -0,0 +1,96 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <sched.h>
+#include <net/if.h>
+
+#include "interface_registry.h"
+#include "command_exec.h"
+
+using namespace std;
+
+static int g_passed = 0;
+static int g_total = 0;
+
+static void check(const string& name, bool ok) {
+    g_total++;
+    cout << "测试: " << name << " ";
+    if (ok) {
+        cout << "✓ 通过" << endl;
+        g_passed++;
+    } else {
+        cout << "✗ 失败" << endl;
+    }
+}
+
+static bool run(const vector<string>& argv) {
+    exec_result res;
+    return exec_command(argv, res, EXEC_CAPTURE_STDERR) == 0 && res.exit_status == 0;
+}
+
+// 等待通知到达并处理，直到cond成立或超时
+template <typename Cond>
+static bool wait_for(InterfaceRegistry& reg, Cond cond) {
+    for (int i = 0; i < 50 && !cond(); i++) {
+        reg.process_notifications(100);
+    }
+    return cond();
+}
+
+int main() {
+    cout << "=== InterfaceRegistry 测试 ===" << endl;
+
+    // 尽量在独立的网络命名空间中测试，不影响宿主机
+    bool own_netns = unshare(CLONE_NEWNET) == 0;
+    cout << (own_netns ? "使用独立网络命名空间" : "无权限创建网络命名空间，仅测试只读查询") << endl;
+
+    InterfaceRegistry reg;
+    interface_info info;
+    check("loopback存在", reg.exists("lo"));
+    check("loopback索引", reg.ifindex("lo") == static_cast<int>(if_nametoindex("lo")));
+    check("loopback标志", reg.lookup("lo", info) && (info.flags & IFF_LOOPBACK) && info.mtu > 0);
+    check("按索引查询", reg.lookup_index(reg.ifindex("lo"), info) && info.name == "lo");
+    check("不存在的接口", !reg.exists("nosuch0") && reg.ifindex("nosuch0") == -1);
+    check("非法接口名", !reg.exists("lo;reboot"));
+
+    if (own_netns) {
+        check("订阅链路通知", reg.subscribe());
+
+        if (run({"ip", "link", "add", "tveth0", "type", "veth", "peer", "name", "tveth1"})) {
+            check("新增veth", wait_for(reg, [&] { return reg.exists("tveth0") && reg.exists("tveth1"); }));
+            check("veth索引一致", reg.ifindex("tveth0") == static_cast<int>(if_nametoindex("tveth0")));
+
+            run({"ip", "link", "set", "tveth0", "mtu", "9000"});
+            check("MTU变更", wait_for(reg, [&] { return reg.lookup("tveth0", info) && info.mtu == 9000; }));
+
+            run({"ip", "link", "set", "tveth0", "name", "tveth9"});
+            check("接口改名", wait_for(reg, [&] { return reg.exists("tveth9") && !reg.exists("tveth0"); }));
+
+            run({"ip", "link", "del", "tveth9"});
+            check("删除veth", wait_for(reg, [&] { return !reg.exists("tveth9") && !reg.exists("tveth1"); }));
+        } else {
+            cout << "无法创建veth接口，跳过增量更新测试" << endl;
+        }
+
+        // 含'-'和'.'的接口名不符合validate_interface_name，但内核允许，必须能查到
+        if (run({"ip", "link", "add", "t-veth.0", "type", "veth", "peer", "name", "br-t1"})) {
+            check("含'-'和'.'的接口名", wait_for(reg, [&] { return reg.exists("t-veth.0") && reg.exists("br-t1"); }) &&
+                                      reg.ifindex("br-t1") == static_cast<int>(if_nametoindex("br-t1")) &&
+                                      reg.lookup("t-veth.0", info) && info.name == "t-veth.0");
+            run({"ip", "link", "del", "t-veth.0"});
+        }
+        check("超长接口名", !reg.exists(string(IFNAMSIZ, 'a')) && reg.ifindex("") == -1);
+
+        if (run({"ip", "link", "add", "tdummy0", "type", "dummy"})) {
+            check("新增dummy", wait_for(reg, [&] { return reg.exists("tdummy0"); }));
+        } else {
+            cout << "内核不支持dummy接口，跳过" << endl;
+        }
+
+        check("后台线程启动", reg.start_watch());
+        reg.stop_watch();
+    }
+
+    cout << "\n测试结果: " << g_passed << "/" << g_total << " 通过" << endl;
+    return g_passed == g_total ? 0 : 1;
+}
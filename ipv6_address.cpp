@@ -0,0 +1,120 @@
+#include "ipv6_address.h"
+#include <arpa/inet.h>
+#include <endian.h>
+
+static const char HEX_DIGITS[] = "0123456789abcdef";
+
+// 写入一个16位组，小写且不带前导零
+static char* put_group(char* p, unsigned v) {
+    bool started = false;
+    for (int shift = 12; shift >= 0; shift -= 4) {
+        unsigned d = (v >> shift) & 0xF;
+        if (d != 0 || started || shift == 0) {
+            *p++ = HEX_DIGITS[d];
+            started = true;
+        }
+    }
+    return p;
+}
+
+// 写入0-255的十进制数
+static char* put_octet(char* p, unsigned v) {
+    if (v >= 100) {
+        *p++ = static_cast<char>('0' + v / 100);
+        v %= 100;
+        *p++ = static_cast<char>('0' + v / 10);
+    } else if (v >= 10) {
+        *p++ = static_cast<char>('0' + v / 10);
+    }
+    *p++ = static_cast<char>('0' + v % 10);
+    return p;
+}
+
+size_t format_ipv6_canonical(const uint8_t addr[16], char* buf) {
+    char* p = buf;
+
+    // ::ffff:0:0/96 映射地址：RFC 5952 第5节建议后32位用点分十进制
+    static const uint8_t MAPPED_PREFIX[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF};
+    if (memcmp(addr, MAPPED_PREFIX, 12) == 0) {
+        memcpy(p, "::ffff:", 7);
+        p += 7;
+        for (int i = 12; i < 16; i++) {
+            if (i > 12) *p++ = '.';
+            p = put_octet(p, addr[i]);
+        }
+        *p = '\0';
+        return static_cast<size_t>(p - buf);
+    }
+
+    unsigned groups[8];
+    for (int i = 0; i < 8; i++) {
+        groups[i] = (static_cast<unsigned>(addr[2 * i]) << 8) | addr[2 * i + 1];
+    }
+
+    // 找最长的连续零组；长度相同时取最左，单个零组不压缩
+    int best_start = -1;
+    int best_len = 1;
+    for (int i = 0; i < 8;) {
+        if (groups[i] != 0) {
+            i++;
+            continue;
+        }
+        int j = i;
+        while (j < 8 && groups[j] == 0) j++;
+        if (j - i > best_len) {
+            best_start = i;
+            best_len = j - i;
+        }
+        i = j;
+    }
+
+    for (int i = 0; i < 8; i++) {
+        if (i == best_start) {
+            *p++ = ':';
+            *p++ = ':';
+            i += best_len - 1;
+            continue;
+        }
+        if (i > 0 && i != best_start + best_len) {
+            *p++ = ':';
+        }
+        p = put_group(p, groups[i]);
+    }
+    *p = '\0';
+    return static_cast<size_t>(p - buf);
+}
+
+// 文本转16字节地址；inet_pton需要NUL结尾，复制到栈上缓冲区
+static bool parse_ipv6_bytes(std::string_view text, uint8_t addr[16]) {
+    if (text.empty() || text.size() >= IPV6_CANONICAL_BUFSIZE) {
+        return false;
+    }
+    char tmp[IPV6_CANONICAL_BUFSIZE];
+    memcpy(tmp, text.data(), text.size());
+    tmp[text.size()] = '\0';
+    return inet_pton(AF_INET6, tmp, addr) == 1;
+}
+
+size_t canonicalize_ipv6(std::string_view text, char* buf) {
+    uint8_t addr[16];
+    if (!parse_ipv6_bytes(text, addr)) {
+        return 0;
+    }
+    return format_ipv6_canonical(addr, buf);
+}
+
+bool parse_ipv6_key(std::string_view text, ipv6_key& out) {
+    uint8_t addr[16];
+    if (!parse_ipv6_bytes(text, addr)) {
+        return false;
+    }
+    out = ipv6_key::from_bytes(addr);
+    return true;
+}
+
+bool ipv6_key::operator<(const ipv6_key& o) const {
+    // hi/lo按内存原样保存网络字节序，比较前转成主机序
+    uint64_t a = be64toh(hi), b = be64toh(o.hi);
+    if (a != b) return a < b;
+    return be64toh(lo) < be64toh(o.lo);
+}
@@ -0,0 +1,71 @@
+#ifndef IPV6_ADDRESS_H
+#define IPV6_ADDRESS_H
+
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+// RFC 5952 规范文本的最大长度（含结尾NUL），与INET6_ADDRSTRLEN相同
+constexpr size_t IPV6_CANONICAL_BUFSIZE = 46;
+
+// 按RFC 5952格式化16字节地址（网络字节序）到调用方缓冲区，不分配内存
+// 小写十六进制、去掉前导零、最长的连续零组（至少两组，长度相同取最左）压缩为"::"，
+// ::ffff:0:0/96 映射地址输出为 ::ffff:a.b.c.d
+// buf至少IPV6_CANONICAL_BUFSIZE字节，返回写入的长度（不含NUL）
+size_t format_ipv6_canonical(const uint8_t addr[16], char* buf);
+
+// 将任意合法写法的IPv6地址规范化为RFC 5952形式
+// 如 "2001:0db8:0000::1"、"2001:DB8:0:0:0:0:0:1" 都输出 "2001:db8::1"
+// 输入无效时返回0，成功时返回写入的长度
+size_t canonicalize_ipv6(std::string_view text, char* buf);
+
+// 16字节二进制地址键，用于按地址建表，代替变长字符串键
+// 以两个64位整数保存，比较和哈希都是定长操作
+struct ipv6_key {
+    uint64_t hi;    // 地址前8字节（网络字节序原样拷贝）
+    uint64_t lo;    // 地址后8字节
+
+    static ipv6_key from_bytes(const uint8_t addr[16]) {
+        ipv6_key k;
+        memcpy(&k.hi, addr, 8);
+        memcpy(&k.lo, addr + 8, 8);
+        return k;
+    }
+
+    void to_bytes(uint8_t addr[16]) const {
+        memcpy(addr, &hi, 8);
+        memcpy(addr + 8, &lo, 8);
+    }
+
+    bool operator==(const ipv6_key& o) const { return hi == o.hi && lo == o.lo; }
+    bool operator!=(const ipv6_key& o) const { return !(*this == o); }
+    // 按地址数值大小排序（与memcmp字节序一致）
+    bool operator<(const ipv6_key& o) const;
+};
+
+// 解析IPv6文本为键；所有等价写法得到同一个键，输入无效时返回false
+bool parse_ipv6_key(std::string_view text, ipv6_key& out);
+
+// 键格式化为RFC 5952文本，返回写入的长度
+inline size_t format_ipv6_key(const ipv6_key& key, char* buf) {
+    uint8_t addr[16];
+    key.to_bytes(addr);
+    return format_ipv6_canonical(addr, buf);
+}
+
+// 哈希：两个64位字乘法混合，适用于unordered_map等哈希表
+struct ipv6_key_hash {
+    size_t operator()(const ipv6_key& k) const {
+        uint64_t h = (k.hi ^ (k.lo * 0x9E3779B97F4A7C15ULL)) * 0xBF58476D1CE4E5B9ULL;
+        return static_cast<size_t>(h ^ (h >> 31));
+    }
+};
+
+namespace std {
+template <>
+struct hash<ipv6_key> : ipv6_key_hash {};
+}
+
+#endif // IPV6_ADDRESS_H
@@ -0,0 +1,119 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <random>
+#include <unordered_map>
+#include <map>
+#include <arpa/inet.h>
+
+#include "ipv6_address.h"
+
+using namespace std;
+
+static int g_passed = 0;
+static int g_total = 0;
+
+static void check(const string& name, bool ok) {
+    g_total++;
+    cout << "测试: " << name << " ";
+    if (ok) {
+        cout << "✓ 通过" << endl;
+        g_passed++;
+    } else {
+        cout << "✗ 失败" << endl;
+    }
+}
+
+static string canon(const string& s) {
+    char buf[IPV6_CANONICAL_BUFSIZE];
+    size_t n = canonicalize_ipv6(s, buf);
+    return string(buf, n);
+}
+
+int main() {
+    cout << "=== IPv6 规范化测试 ===" << endl;
+
+    vector<pair<string, string>> cases = {
+        {"2001:0db8:0000::1", "2001:db8::1"},
+        {"2001:db8::1", "2001:db8::1"},
+        {"2001:DB8:0:0:0:0:0:1", "2001:db8::1"},
+        {"2001:0db8:0000:0000:0000:0000:0000:0001", "2001:db8::1"},
+        {"::", "::"},
+        {"::1", "::1"},
+        {"0:0:0:0:0:0:0:0", "::"},
+        {"1:0:0:0:0:0:0:0", "1::"},
+        {"2001:db8:0:1:1:1:1:1", "2001:db8:0:1:1:1:1:1"},     // 单个零组不压缩
+        {"2001:0:0:1:0:0:0:1", "2001:0:0:1::1"},              // 取最长的零串
+        {"2001:db8:0:0:1:0:0:1", "2001:db8::1:0:0:1"},        // 长度相同取最左
+        {"FE80::0202:B3FF:FE1E:8329", "fe80::202:b3ff:fe1e:8329"},
+        {"::ffff:192.0.2.1", "::ffff:192.0.2.1"},
+        {"::FFFF:C000:0201", "::ffff:192.0.2.1"},
+        {"ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff", "ffff:ffff:ffff:ffff:ffff:ffff:ffff:ffff"},
+    };
+    for (const auto& c : cases) {
+        check("规范化 " + c.first, canon(c.first) == c.second);
+    }
+
+    check("无效输入返回0", canon("1::2::3").empty() && canon("").empty() && canon("12345::").empty()
+          && canon("192.168.1.1").empty() && canon(string(60, ':')).empty());
+
+    // 等价写法得到同一个键
+    ipv6_key a, b, c;
+    bool ok = parse_ipv6_key("2001:0db8:0000::1", a)
+              && parse_ipv6_key("2001:DB8:0:0:0:0:0:1", b)
+              && parse_ipv6_key("2001:db8::2", c);
+    check("等价写法键相同", ok && a == b && a != c);
+    check("键按地址大小排序", ok && a < c && !(c < a) && !(a < b));
+    check("哈希一致", ipv6_key_hash()(a) == ipv6_key_hash()(b));
+
+    char buf[IPV6_CANONICAL_BUFSIZE];
+    size_t n = format_ipv6_key(a, buf);
+    check("键格式化", string(buf, n) == "2001:db8::1");
+
+    unordered_map<ipv6_key, int> peers;
+    for (const char* s : {"2001:0db8:0000::1", "2001:db8::1", "2001:DB8:0:0:0:0:0:1", "::1"}) {
+        ipv6_key k;
+        if (parse_ipv6_key(s, k)) peers[k]++;
+    }
+    check("按键去重", peers.size() == 2 && peers[a] == 3);
+
+    // 随机地址：与inet_ntop比对（inet_ntop对前96位为零的地址另有写法，跳过），
+    // 并验证规范文本可以无损解析回原地址，排序与memcmp一致
+    mt19937_64 rng(12345);
+    int mismatches = 0;
+    int order_errors = 0;
+    ipv6_key prev = {0, 0};
+    uint8_t prev_bytes[16] = {0};
+    for (int i = 0; i < 200000; i++) {
+        uint8_t addr[16];
+        for (int j = 0; j < 8; j++) {
+            // 提高零组的比例，覆盖各种压缩位置
+            uint16_t g = (rng() % 3 == 0) ? 0 : static_cast<uint16_t>(rng() >> (rng() % 16));
+            addr[2 * j] = static_cast<uint8_t>(g >> 8);
+            addr[2 * j + 1] = static_cast<uint8_t>(g);
+        }
+        n = format_ipv6_canonical(addr, buf);
+        uint8_t back[16];
+        if (inet_pton(AF_INET6, buf, back) != 1 || memcmp(back, addr, 16) != 0) {
+            mismatches++;
+            continue;
+        }
+        static const uint8_t zero12[12] = {0};
+        if (memcmp(addr, zero12, 12) != 0) {
+            char ref[INET6_ADDRSTRLEN];
+            inet_ntop(AF_INET6, addr, ref, sizeof(ref));
+            if (string(buf, n) != ref) mismatches++;
+        }
+        ipv6_key k = ipv6_key::from_bytes(addr);
+        int cmp = memcmp(prev_bytes, addr, 16);
+        if ((cmp < 0) != (prev < k)) order_errors++;
+        prev = k;
+        memcpy(prev_bytes, addr, 16);
+    }
+    check("随机地址与inet_ntop一致且可逆", mismatches == 0);
+    check("随机地址排序与memcmp一致", order_errors == 0);
+
+    cout << endl << "测试结果: " << g_passed << "/" << g_total << " 通过" << endl;
+    return g_passed == g_total ? 0 : 1;
+}
@@ -0,0 +1,209 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+
+#include "host_validator.h"
+#include "input_validation.h"
+#include "srt_url_parser.h"
+#include "srt_streamid.h"
+#include "ipv6_address.h"
+#include <arpa/inet.h>
+
+using namespace std;
+
+static int g_passed = 0;
+static int g_total = 0;
+
+static void check(const string& name, bool ok) {
+    g_total++;
+    cout << "测试: " << name << " ";
+    if (ok) {
+        cout << "✓ 通过" << endl;
+        g_passed++;
+    } else {
+        cout << "✗ 失败" << endl;
+    }
+}
+
+// 最坏耗时测试：对抗性语料逐条计时，输出各函数的p99/p999/max。
+// 用法：latency_budget_test [预算倍数]
+// 绝对耗时依赖机器和负载，默认只输出不检查；在专用机器上可传入倍数（如1）按下面的预算检查，
+// 在较慢的环境（如sanitizer构建）可传入更大的倍数。默认检查的是与机器无关的长度上限：
+// 超过上限的输入在扫描前即被拒绝，最坏耗时因此有固定上界
+
+// 单次调用耗时预算（纳秒），乘以命令行给出的倍数
+// 每个输入重复测量取最小值，排除调度和中断带来的偶发抖动，只反映算法本身的最坏耗时
+const long long BUDGET_P99_NS = 50 * 1000;
+const long long BUDGET_P999_NS = 200 * 1000;
+const long long BUDGET_MAX_NS = 1000 * 1000;
+const int REPEAT = 3;
+
+static string repeat(const string& unit, size_t count) {
+    string s;
+    s.reserve(unit.size() * count);
+    for (size_t i = 0; i < count; i++) s += unit;
+    return s;
+}
+
+// 对抗性语料：回溯型正则的最坏输入、超长输入、大量分隔符等
+static vector<string> build_corpus() {
+    vector<string> corpus;
+    const vector<string> units = {
+        "a", "a-", "a.", "-", ".", "1", "1.", "1.1", ":", "::", "ffff:", "1:", "::ffff:",
+        "../", "/", "9", "a=", "a=b&", "&", "=", ",", "k=,", "1.1.1.1:1,", "[", "]", "%",
+        "\xff", " ", "0", "00.",
+    };
+    const vector<size_t> counts = {1, 2, 31, 32, 63, 64, 127, 253, 254, 1000, 4096, 4097, 100000};
+    for (const string& unit : units) {
+        for (size_t n : counts) {
+            string body = repeat(unit, n);
+            corpus.push_back(body);
+            corpus.push_back(body + "!");
+            corpus.push_back("srt://" + body);
+            corpus.push_back("srt://h:1?" + body);
+            corpus.push_back("#!::" + body);
+        }
+    }
+
+    // 正则回溯最坏情况：接近上限的长标签，最后一个字符非法
+    for (size_t n : {61, 62, 63, 64}) {
+        string label = repeat("a", n);
+        corpus.push_back(repeat(label + ".", 253 / (n + 1)) + "-");
+        corpus.push_back(repeat(label + "-", 253 / (n + 1)) + "!");
+        corpus.push_back("a" + repeat("-", n) + "a");
+    }
+    corpus.push_back("srt://h:1?" + repeat("streamid=" + repeat("x", 500) + "&", 8));
+    corpus.push_back("srt://" + repeat("10.0.0.1:9000;weight=1;priority=1,", 100) + "10.0.0.1:9000");
+    corpus.push_back(string(1 << 20, 'a'));
+    corpus.push_back(string(1 << 20, '9'));
+
+    // 随机短输入，让百分位数有意义
+    mt19937 rng(46);
+    const char alphabet[] = "aZ09-.:/[]%&=,;?#!_ \t";
+    for (int i = 0; i < 3000; i++) {
+        string s = (i % 3 == 0) ? "srt://" : "";
+        size_t n = rng() % 300;
+        for (size_t j = 0; j < n; j++) s += alphabet[rng() % (sizeof(alphabet) - 1)];
+        corpus.push_back(s);
+    }
+    return corpus;
+}
+
+struct target {
+    const char* name;
+    function<void(const string&)> call;
+};
+
+static long long measure_ns(const target& t, const string& input) {
+    long long best = -1;
+    for (int r = 0; r < REPEAT; r++) {
+        auto start = chrono::steady_clock::now();
+        t.call(input);
+        auto stop = chrono::steady_clock::now();
+        long long ns = chrono::duration_cast<chrono::nanoseconds>(stop - start).count();
+        if (best < 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    cout << "=== 最坏耗时预算测试 ===" << endl;
+
+    double budget_scale = argc > 1 ? atof(argv[1]) : 0.0;
+    if (budget_scale > 0) {
+        cout << "按预算检查，倍数: " << budget_scale << endl;
+    } else {
+        cout << "未指定预算倍数，只输出耗时不检查" << endl;
+    }
+
+    vector<string> corpus = build_corpus();
+    cout << "语料条数: " << corpus.size() << endl;
+
+    // 防止结果被优化掉
+    static volatile int sink = 0;
+    const vector<target> targets = {
+        {"is_valid_host", [](const string& s) { sink += is_valid_host(s); }},
+        {"is_valid_host_reference", [](const string& s) { sink += is_valid_host_reference(s); }},
+        {"classify_host", [](const string& s) { unsigned char a[16]; sink += classify_host(s, a); }},
+        {"validate_ipv4", [](const string& s) { sink += validate_ipv4(s); }},
+        {"validate_ipv6", [](const string& s) { sink += validate_ipv6(s); }},
+        {"validate_netmask", [](const string& s) { sink += validate_netmask(s); }},
+        {"validate_mac_address", [](const string& s) { sink += validate_mac_address(s); }},
+        {"validate_interface_name", [](const string& s) { sink += validate_interface_name(s); }},
+        {"validate_hostname", [](const string& s) { sink += validate_hostname(s); }},
+        {"validate_filepath", [](const string& s) { sink += validate_filepath(s); }},
+        {"validate_numeric", [](const string& s) { sink += validate_numeric(s); }},
+        {"validate_numeric(range)", [](const string& s) { sink += validate_numeric(s, 0, 65535); }},
+        {"validate_alphanumeric", [](const string& s) { sink += validate_alphanumeric(s); }},
+        {"parse_ipv4", [](const string& s) { uint32_t v; sink += parse_ipv4(s.data(), s.size(), v); }},
+        {"canonicalize_ipv6", [](const string& s) {
+            char buf[IPV6_CANONICAL_BUFSIZE]; sink += static_cast<int>(canonicalize_ipv6(s, buf)); }},
+        {"parse_srt_url", [](const string& s) { srt_options opt; sink += parse_srt_url(s, opt); }},
+        {"parse_srt_group_url", [](const string& s) { srt_group_options g; sink += parse_srt_group_url(s, g); }},
+        {"parse_srt_streamid", [](const string& s) { srt_streamid sid; sink += parse_srt_streamid(s, sid); }},
+    };
+
+    // 预热
+    for (const target& t : targets) {
+        for (size_t i = 0; i < 100; i++) t.call(corpus[i]);
+    }
+
+    cout << left << setw(26) << "函数" << right << setw(10) << "p99(ns)" << setw(10) << "p999(ns)"
+         << setw(10) << "max(ns)" << "  最慢输入长度" << endl;
+    for (const target& t : targets) {
+        vector<long long> costs;
+        costs.reserve(corpus.size());
+        long long worst = -1;
+        size_t worst_len = 0;
+        for (const string& input : corpus) {
+            long long ns = measure_ns(t, input);
+            costs.push_back(ns);
+            if (ns > worst) {
+                worst = ns;
+                worst_len = input.size();
+            }
+        }
+        sort(costs.begin(), costs.end());
+        long long p99 = costs[costs.size() * 99 / 100];
+        long long p999 = costs[costs.size() * 999 / 1000];
+        cout << left << setw(26) << t.name << right << setw(10) << p99 << setw(10) << p999
+             << setw(10) << worst << "  " << worst_len << endl;
+        if (budget_scale > 0) {
+            check(string(t.name) + " 在预算内",
+                  p99 <= BUDGET_P99_NS * budget_scale && p999 <= BUDGET_P999_NS * budget_scale &&
+                  worst <= BUDGET_MAX_NS * budget_scale);
+        }
+    }
+
+    // 长度上限
+    srt_options opt;
+    srt_streamid sid;
+    check("超长SRT URL被拒绝", parse_srt_url("srt://h:1?streamid=" + string(SRT_URL_MAX_LENGTH, 'x'), opt) == -1);
+    check("超长streamid被拒绝", !parse_srt_streamid(string(SRT_STREAMID_MAX_LENGTH + 1, 'x'), sid));
+    check("上限内的streamid", parse_srt_streamid(string(SRT_STREAMID_MAX_LENGTH, 'x'), sid));
+    check("超长路径被拒绝", !validate_filepath(string(MAX_VALIDATED_LENGTH + 1, 'a')) &&
+                            validate_filepath(string(MAX_VALIDATED_LENGTH, 'a')));
+    check("超长数字和字母数字串被拒绝",
+          !validate_numeric(string(MAX_VALIDATED_LENGTH + 1, '9')) && validate_numeric(string(MAX_VALIDATED_LENGTH, '9')) &&
+          !validate_alphanumeric(string(MAX_VALIDATED_LENGTH + 1, 'a')) &&
+          validate_alphanumeric(string(MAX_VALIDATED_LENGTH, 'a')));
+    check("超长主机被拒绝", !is_valid_host(string(1 << 20, 'a')) && !is_valid_host_reference(string(1 << 20, 'a')) &&
+                            !validate_hostname(string(1 << 20, 'a')));
+    check("超长地址被拒绝", !validate_ipv4("1.2.3.4" + string(INET_ADDRSTRLEN, ' ')) &&
+                            !validate_ipv6("::1" + string(INET6_ADDRSTRLEN, ' ')) &&
+                            !validate_netmask("255.0.0.0" + string(INET_ADDRSTRLEN, ' ')));
+    check("参考实现的域名格式检查",
+          is_valid_host_reference("a-b.example.com") && is_valid_host_reference(repeat("a", 63) + ".com") &&
+          !is_valid_host_reference(repeat("a", 64) + ".com") && !is_valid_host_reference("a-.com") &&
+          !is_valid_host_reference("-a.com") && !is_valid_host_reference("a..com") &&
+          !is_valid_host_reference("a_b.com"));
+
+    cout << endl << "测试结果: " << g_passed << "/" << g_total << " 通过" << endl;
+    return g_passed == g_total ? 0 : 1;
+}
@@ -0,0 +1,122 @@
+#include "netval_c.h"
+#include "host_validator.h"
+#include "srt_url_parser.h"
+#include <cstring>
+#include <string>
+
+// 复制字符串到定长缓冲区，超长时截断并返回false
+static bool copy_field(char* dst, size_t cap, const std::string& src) {
+    size_t n = src.size() < cap - 1 ? src.size() : cap - 1;
+    memcpy(dst, src.data(), n);
+    dst[n] = '\0';
+    return n == src.size();
+}
+
+static void fill_options(const srt_options& opt, int rc, netval_srt_options* out) {
+    memset(out, 0, sizeof(*out));
+    out->port = opt.port;
+    out->pbkeylen = opt.pbkeylen;
+    out->latency = opt.latency;
+    out->maxbw = opt.maxbw;
+    out->rcvbuf = opt.rcvbuf;
+    out->sndbuf = opt.sndbuf;
+    out->ipttl = opt.ipttl;
+    out->conntimeo = opt.conntimeo;
+    out->host_type = opt.host_type;
+    memcpy(out->host_addr, opt.host_addr, sizeof(out->host_addr));
+
+    bool complete = copy_field(out->mode, sizeof(out->mode), opt.mode);
+    complete &= copy_field(out->host, sizeof(out->host), opt.host);
+    complete &= copy_field(out->streamid, sizeof(out->streamid), opt.streamid);
+    complete &= copy_field(out->passphrase, sizeof(out->passphrase), opt.passphrase);
+
+    if (rc != 0) {
+        out->status = NETVAL_ERR_PARSE;
+    } else {
+        out->status = complete ? NETVAL_OK : NETVAL_ERR_TRUNCATED;
+    }
+}
+
+uint32_t netval_abi_version(void) {
+    return NETVAL_ABI_VERSION;
+}
+
+int netval_is_valid_host(const char* host, size_t len) {
+    if (host == nullptr) {
+        return 0;
+    }
+    return is_valid_host_view(std::string_view(host, len)) ? 1 : 0;
+}
+
+size_t netval_is_valid_host_batch(const char* const* hosts, const size_t* lens,
+                                  size_t count, uint8_t* results) {
+    if (hosts == nullptr || lens == nullptr || results == nullptr) {
+        return 0;
+    }
+    // 直接在调用方的缓冲区上校验，不逐条复制
+    size_t valid = 0;
+    for (size_t i = 0; i < count; i++) {
+        bool ok = false;
+        if (hosts[i] != nullptr) {
+            ok = is_valid_host_view(std::string_view(hosts[i], lens[i]));
+        }
+        results[i] = ok ? 1 : 0;
+        valid += ok ? 1 : 0;
+    }
+    return valid;
+}
+
+size_t netval_is_valid_host_packed(const char* data, const size_t* offsets,
+                                   size_t count, uint8_t* results) {
+    if (offsets == nullptr || results == nullptr || (data == nullptr && count > 0)) {
+        return 0;
+    }
+    size_t valid = 0;
+    for (size_t i = 0; i < count; i++) {
+        bool ok = false;
+        if (offsets[i + 1] >= offsets[i]) {
+            ok = is_valid_host_view(std::string_view(data + offsets[i], offsets[i + 1] - offsets[i]));
+        }
+        results[i] = ok ? 1 : 0;
+        valid += ok ? 1 : 0;
+    }
+    return valid;
+}
+
+int netval_parse_srt_url(const char* url, size_t len, netval_srt_options* out) {
+    if (out == nullptr) {
+        return NETVAL_ERR_ARGUMENT;
+    }
+    if (url == nullptr) {
+        memset(out, 0, sizeof(*out));
+        out->status = NETVAL_ERR_ARGUMENT;
+        return out->status;
+    }
+    srt_options opt;
+    int rc = parse_srt_url(std::string(url, len), opt);
+    fill_options(opt, rc, out);
+    return out->status;
+}
+
+size_t netval_parse_srt_url_batch(const char* const* urls, const size_t* lens,
+                                  size_t count, netval_srt_options* out) {
+    if (urls == nullptr || lens == nullptr || out == nullptr) {
+        return 0;
+    }
+    // 复用URL缓冲区和srt_options，字符串字段的容量在批内复用
+    std::string scratch;
+    srt_options opt;
+    size_t ok = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (urls[i] == nullptr) {
+            memset(&out[i], 0, sizeof(out[i]));
+            out[i].status = NETVAL_ERR_ARGUMENT;
+            continue;
+        }
+        scratch.assign(urls[i], lens[i]);
+        int rc = parse_srt_url(scratch, opt);
+        fill_options(opt, rc, &out[i]);
+        ok += out[i].status == NETVAL_OK ? 1 : 0;
+    }
+    return ok;
+}
@@ -0,0 +1,95 @@
+#ifndef NETVAL_C_H
+#define NETVAL_C_H
+
+/*
+ * 稳定的C ABI，供Go(cgo)/Python(ctypes/cffi)等FFI调用方使用
+ *
+ * - 所有输入都是 指针+长度，不要求以NUL结尾，也不需要构造std::string
+ * - 批量接口一次FFI调用处理成千上万条记录，结果写入调用方提供的数组
+ * - 结构体均为POD，字段只追加不修改；布局变化时NETVAL_ABI_VERSION加1
+ *
+ * 编译为共享库时与 host_validator.cpp、srt_url_parser.cpp 等实现文件一起链接，
+ * 并使用 -fvisibility=hidden，只导出带NETVAL_API标记的符号。
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__GNUC__)
+#define NETVAL_API __attribute__((visibility("default")))
+#else
+#define NETVAL_API
+#endif
+
+#define NETVAL_ABI_VERSION 1
+
+/* 定长字段容量（含结尾NUL） */
+#define NETVAL_MODE_MAX        16
+#define NETVAL_HOST_MAX        256
+#define NETVAL_STREAMID_MAX    513
+#define NETVAL_PASSPHRASE_MAX  80
+
+/* netval_srt_options::status */
+#define NETVAL_OK              0    /* 解析成功 */
+#define NETVAL_ERR_PARSE      -1    /* URL格式错误 */
+#define NETVAL_ERR_TRUNCATED  -2    /* 解析成功，但有字段超过定长容量（已截断） */
+#define NETVAL_ERR_ARGUMENT   -3    /* 参数为空指针 */
+
+/* srt_options的POD版本，字符串字段以NUL结尾 */
+typedef struct netval_srt_options {
+    int32_t status;
+    int32_t port;
+    int32_t pbkeylen;
+    int32_t latency;
+    int32_t maxbw;
+    int32_t rcvbuf;
+    int32_t sndbuf;
+    int32_t ipttl;
+    int32_t conntimeo;
+    char mode[NETVAL_MODE_MAX];
+    char host[NETVAL_HOST_MAX];
+    char streamid[NETVAL_STREAMID_MAX];
+    char passphrase[NETVAL_PASSPHRASE_MAX];
+    int32_t host_type;          /* host_kind：0无/无效，1 IPv4，2 IPv6，3 域名 */
+    uint8_t host_addr[16];      /* IPv4(前4字节)/IPv6的网络字节序地址 */
+} netval_srt_options;
+
+/* 返回编译时的NETVAL_ABI_VERSION，调用方据此检查兼容性 */
+NETVAL_API uint32_t netval_abi_version(void);
+
+/* 主机地址验证（同is_valid_host），有效返回1，否则返回0 */
+NETVAL_API int netval_is_valid_host(const char* host, size_t len);
+
+/*
+ * 批量主机地址验证
+ * hosts[i]/lens[i]为第i个主机，results[i]写入1/0，返回有效个数
+ */
+NETVAL_API size_t netval_is_valid_host_batch(const char* const* hosts, const size_t* lens,
+                                             size_t count, uint8_t* results);
+
+/*
+ * 批量主机地址验证（紧凑缓冲区形式）
+ * 所有主机连续存放在data中，第i个为data[offsets[i], offsets[i+1])，offsets长度为count+1
+ */
+NETVAL_API size_t netval_is_valid_host_packed(const char* data, const size_t* offsets,
+                                              size_t count, uint8_t* results);
+
+/* SRT URL解析（同parse_srt_url），返回out->status */
+NETVAL_API int netval_parse_srt_url(const char* url, size_t len, netval_srt_options* out);
+
+/*
+ * 批量SRT URL解析
+ * out[i]对应urls[i]/lens[i]，返回status为NETVAL_OK的个数
+ */
+NETVAL_API size_t netval_parse_srt_url_batch(const char* const* urls, const size_t* lens,
+                                             size_t count, netval_srt_options* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NETVAL_C_H */
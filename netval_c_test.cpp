@@ -0,0 +1,154 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstring>
+
+#include "netval_c.h"
+#include "validation_metrics.h"
+#include "shadow_verify.h"
+
+using namespace std;
+
+// 被测函数只通过extern "C"接口调用，检查FFI调用方看到的行为；统计和影子校验用C++接口观察
+
+static int g_passed = 0;
+static int g_total = 0;
+
+static void check(const string& name, bool ok) {
+    g_total++;
+    cout << "测试: " << name << " ";
+    if (ok) {
+        cout << "✓ 通过" << endl;
+        g_passed++;
+    } else {
+        cout << "✗ 失败" << endl;
+    }
+}
+
+static int parse(const string& url, netval_srt_options* out) {
+    return netval_parse_srt_url(url.data(), url.size(), out);
+}
+
+int main() {
+    cout << "=== C ABI测试 ===" << endl;
+
+    check("ABI版本", netval_abi_version() == NETVAL_ABI_VERSION);
+
+    // 单条主机验证：输入按长度截取，不要求NUL结尾
+    const char buf[] = "example.com;rm";
+    check("主机验证", netval_is_valid_host("example.com", 11) == 1 &&
+                      netval_is_valid_host("192.168.1.1", 11) == 1 &&
+                      netval_is_valid_host("bad_host", 8) == 0 &&
+                      netval_is_valid_host("", 0) == 0);
+    check("按长度截取输入", netval_is_valid_host(buf, 11) == 1 && netval_is_valid_host(buf, sizeof(buf) - 1) == 0);
+    check("主机为空指针", netval_is_valid_host(nullptr, 5) == 0);
+
+    // 批量
+    const char* hosts[] = {"example.com", "bad_host", nullptr, "2001:db8::1"};
+    size_t lens[] = {11, 8, 3, 11};
+    uint8_t results[4] = {9, 9, 9, 9};
+    size_t valid = netval_is_valid_host_batch(hosts, lens, 4, results);
+    check("批量主机验证", valid == 2 && results[0] == 1 && results[1] == 0 && results[2] == 0 && results[3] == 1);
+    check("批量参数为空", netval_is_valid_host_batch(nullptr, lens, 4, results) == 0 &&
+                          netval_is_valid_host_batch(hosts, nullptr, 4, results) == 0 &&
+                          netval_is_valid_host_batch(hosts, lens, 4, nullptr) == 0 &&
+                          netval_is_valid_host_batch(hosts, lens, 0, results) == 0);
+
+    // 紧凑缓冲区：offsets[i+1] < offsets[i]的记录视为无效，不越界读取
+    string data = "example.combad_host10.0.0.1";
+    size_t offsets[] = {0, 11, 19, 27, 5, 27};
+    uint8_t packed[5] = {9, 9, 9, 9, 9};
+    valid = netval_is_valid_host_packed(data.data(), offsets, 5, packed);
+    check("紧凑缓冲区主机验证", valid == 2 && packed[0] == 1 && packed[1] == 0 && packed[2] == 1);
+    check("偏移量倒退视为无效", packed[3] == 0 && packed[4] == 0);
+    size_t empty_offsets[] = {0};
+    check("紧凑缓冲区参数为空", netval_is_valid_host_packed(data.data(), nullptr, 1, packed) == 0 &&
+                                netval_is_valid_host_packed(data.data(), offsets, 1, nullptr) == 0 &&
+                                netval_is_valid_host_packed(nullptr, offsets, 1, packed) == 0 &&
+                                netval_is_valid_host_packed(nullptr, empty_offsets, 0, packed) == 0);
+
+    // 直接在调用方缓冲区上校验，仍然经过统计和影子校验
+    metrics_reset();
+    metrics_enable(true);
+    shadow_enable(1);
+    netval_is_valid_host_batch(hosts, lens, 4, results);
+    netval_is_valid_host_packed(data.data(), offsets, 3, packed);
+    shadow_flush();
+    metrics_enable(false);
+    metrics_snapshot snap;
+    metrics_read(snap);
+    shadow_stats shadow;
+    shadow_read(shadow);
+    shadow_disable();
+    check("主机验证计入统计和影子校验", snap.funcs[METRIC_IS_VALID_HOST].calls == 6 &&
+                                        snap.funcs[METRIC_IS_VALID_HOST].rejects == 2 &&
+                                        shadow.checked[SHADOW_IS_VALID_HOST] == 6 &&
+                                        shadow.mismatches[SHADOW_IS_VALID_HOST] == 0);
+
+    // SRT URL解析
+    netval_srt_options opt;
+    int rc = parse("srt://192.168.1.1:9000?latency=200&streamid=live/cam1&pbkeylen=16", &opt);
+    check("SRT解析成功", rc == NETVAL_OK && opt.status == NETVAL_OK && opt.port == 9000 &&
+                         opt.latency == 200 && opt.pbkeylen == 16 && opt.maxbw == -1 &&
+                         strcmp(opt.mode, "caller") == 0 && strcmp(opt.host, "192.168.1.1") == 0 &&
+                         strcmp(opt.streamid, "live/cam1") == 0 && opt.passphrase[0] == '\0');
+    const uint8_t v4[4] = {192, 168, 1, 1};
+    check("SRT主机类型和地址", opt.host_type == 1 && memcmp(opt.host_addr, v4, 4) == 0);
+    rc = parse("srt://[2001:db8::1]:9000", &opt);
+    check("SRT IPv6主机", rc == NETVAL_OK && opt.host_type == 2 && opt.host_addr[0] == 0x20 &&
+                          opt.host_addr[1] == 0x01 && opt.host_addr[15] == 1 && strcmp(opt.host, "2001:db8::1") == 0);
+
+    rc = parse("http://example.com", &opt);
+    check("NETVAL_ERR_PARSE", rc == NETVAL_ERR_PARSE && opt.status == NETVAL_ERR_PARSE);
+
+    // 字段超过定长容量：解析成功但截断，字符串仍以NUL结尾
+    string long_streamid(NETVAL_STREAMID_MAX + 10, 's');
+    rc = parse("srt://example.com:9000?streamid=" + long_streamid, &opt);
+    check("streamid超长截断", rc == NETVAL_ERR_TRUNCATED && opt.status == NETVAL_ERR_TRUNCATED &&
+                              strlen(opt.streamid) == NETVAL_STREAMID_MAX - 1 && opt.port == 9000);
+    string exact_streamid(NETVAL_STREAMID_MAX - 1, 's');
+    rc = parse("srt://example.com:9000?streamid=" + exact_streamid, &opt);
+    check("streamid恰好填满不截断", rc == NETVAL_OK && strlen(opt.streamid) == NETVAL_STREAMID_MAX - 1);
+    rc = parse("srt://example.com:9000?passphrase=" + string(NETVAL_PASSPHRASE_MAX, 'p'), &opt);
+    check("passphrase超长截断", rc == NETVAL_ERR_TRUNCATED && strlen(opt.passphrase) == NETVAL_PASSPHRASE_MAX - 1);
+    // 超过定长字段的主机名本身就超出域名长度上限，解析失败而不是截断
+    string long_host;
+    while (long_host.size() < NETVAL_HOST_MAX) long_host += string(30, 'h') + ".";
+    long_host += "com";
+    rc = parse("srt://" + long_host + ":9000", &opt);
+    check("host超长", rc == NETVAL_ERR_PARSE && strlen(opt.host) < NETVAL_HOST_MAX);
+
+    // 空指针参数
+    check("输出为空指针", netval_parse_srt_url("srt://a:1", 9, nullptr) == NETVAL_ERR_ARGUMENT);
+    memset(&opt, 0x7f, sizeof(opt));
+    rc = netval_parse_srt_url(nullptr, 9, &opt);
+    check("URL为空指针", rc == NETVAL_ERR_ARGUMENT && opt.status == NETVAL_ERR_ARGUMENT &&
+                         opt.host[0] == '\0' && opt.port == 0);
+
+    // 批量SRT解析
+    string urls_text[] = {"srt://example.com:9000?mode=caller", "srt://a;b:9000",
+                          "srt://example.com:9000?streamid=" + long_streamid, "srt://:9000?mode=listener"};
+    const char* urls[5];
+    size_t url_lens[5];
+    for (int i = 0; i < 4; i++) {
+        urls[i] = urls_text[i].data();
+        url_lens[i] = urls_text[i].size();
+    }
+    urls[4] = nullptr;
+    url_lens[4] = 0;
+    vector<netval_srt_options> out(5);
+    size_t ok = netval_parse_srt_url_batch(urls, url_lens, 5, out.data());
+    check("批量SRT解析", ok == 2 && out[0].status == NETVAL_OK && out[0].host_type == 3 &&
+                         out[1].status == NETVAL_ERR_PARSE && out[2].status == NETVAL_ERR_TRUNCATED &&
+                         out[3].status == NETVAL_OK && strcmp(out[3].mode, "listener") == 0 &&
+                         out[3].host[0] == '\0' && out[3].port == 9000 &&
+                         out[4].status == NETVAL_ERR_ARGUMENT);
+    // 批内复用的srt_options不把上一条的字段带到下一条
+    check("批量结果互不影响", out[3].streamid[0] == '\0' && out[0].streamid[0] == '\0');
+    check("批量参数为空", netval_parse_srt_url_batch(nullptr, url_lens, 5, out.data()) == 0 &&
+                          netval_parse_srt_url_batch(urls, nullptr, 5, out.data()) == 0 &&
+                          netval_parse_srt_url_batch(urls, url_lens, 5, nullptr) == 0);
+
+    cout << endl << "测试结果: " << g_passed << "/" << g_total << " 通过" << endl;
+    return g_passed == g_total ? 0 : 1;
+}
@@ -0,0 +1,51 @@
+#ifndef PARSE_INT_H
+#define PARSE_INT_H
+
+#include <string_view>
+#include <charconv>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+// 整数解析结果
+enum parse_int_status {
+    PARSE_INT_OK = 0,
+    PARSE_INT_EMPTY,            // 空字符串
+    PARSE_INT_INVALID,          // 不以数字（或负号加数字）开头
+    PARSE_INT_TRAILING,         // 数字后还有其他字符 (如 "120ms")
+    PARSE_INT_OVERFLOW,         // 超出类型T的表示范围
+    PARSE_INT_OUT_OF_RANGE,     // 超出调用方给定的[min, max]
+};
+
+// 严格解析十进制整数，基于std::from_chars，不抛异常、不分配内存
+// 必须整串都是数字（有符号类型允许一个前导'-'），不接受空白和'+'；
+// 失败时out不变，返回失败原因
+template <typename T>
+inline parse_int_status parse_int(std::string_view str, T& out,
+                                  T min_value = std::numeric_limits<T>::min(),
+                                  T max_value = std::numeric_limits<T>::max()) {
+    static_assert(std::is_integral<T>::value, "parse_int只支持整数类型");
+    if (str.empty()) {
+        return PARSE_INT_EMPTY;
+    }
+    const char* first = str.data();
+    const char* last = first + str.size();
+    T value;
+    std::from_chars_result r = std::from_chars(first, last, value, 10);
+    if (r.ec == std::errc::invalid_argument) {
+        return PARSE_INT_INVALID;
+    }
+    if (r.ec == std::errc::result_out_of_range) {
+        return PARSE_INT_OVERFLOW;
+    }
+    if (r.ptr != last) {
+        return PARSE_INT_TRAILING;
+    }
+    if (value < min_value || value > max_value) {
+        return PARSE_INT_OUT_OF_RANGE;
+    }
+    out = value;
+    return PARSE_INT_OK;
+}
+
+#endif // PARSE_INT_H
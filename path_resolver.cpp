@@ -0,0 +1,213 @@
+#include "path_resolver.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <vector>
+#ifdef SYS_openat2
+#include <linux/openat2.h>
+#endif
+
+#ifdef SYS_openat2
+static int openat2_beneath(int dirfd, const char* path, int flags, mode_t mode) {
+    struct open_how how = {};
+    how.flags = static_cast<uint64_t>(flags | O_CLOEXEC);
+    // O_TMPFILE包含O_DIRECTORY位，需按完整取值比较，否则普通目录打开也会带上mode而被拒绝(EINVAL)
+    how.mode = ((flags & O_CREAT) || (flags & O_TMPFILE) == O_TMPFILE) ? mode : 0;
+    // 与回退路径一致：任何分量是符号链接都拒绝，包括指向根目录内部的链接
+    how.resolve = RESOLVE_BENEATH | RESOLVE_NO_SYMLINKS;
+    return static_cast<int>(syscall(SYS_openat2, dirfd, path, &how, sizeof(how)));
+}
+#endif
+
+PathResolver::DirFd::~DirFd() {
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+PathResolver::PathResolver(const std::string& root, size_t max_cached_dirs)
+    : root_fd_(-1), max_cached_(max_cached_dirs), use_openat2_(false) {
+    root_fd_ = ::open(root.c_str(), O_PATH | O_DIRECTORY | O_CLOEXEC);
+#ifdef SYS_openat2
+    // 探测一次：旧内核返回ENOSYS，容器的seccomp策略常把未知系统调用拒绝为EPERM，
+    // 根目录下打开"."不会因权限失败，因此任何错误都说明openat2不可用
+    if (root_fd_ >= 0) {
+        int fd = openat2_beneath(root_fd_, ".", O_PATH | O_DIRECTORY, 0);
+        if (fd >= 0) {
+            close(fd);
+            use_openat2_ = true;
+        }
+    }
+#endif
+}
+
+PathResolver::~PathResolver() {
+    clear_cache();
+    if (root_fd_ >= 0) {
+        close(root_fd_);
+    }
+}
+
+void PathResolver::clear_cache() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    dir_cache_.clear();
+}
+
+size_t PathResolver::cached_dirs() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return dir_cache_.size();
+}
+
+// 在dirfd下打开path，保证不逃出dirfd
+int PathResolver::open_beneath(int dirfd, const char* path, int flags, mode_t mode) {
+#ifdef SYS_openat2
+    if (use_openat2_) {
+        int fd = openat2_beneath(dirfd, path, flags, mode);
+        if (fd >= 0 || errno != ENOSYS) {
+            return fd;
+        }
+        // 内核不支持openat2，此后一律走回退路径
+        use_openat2_ = false;
+    }
+#endif
+    return walk_nofollow(dirfd, path, flags, mode);
+}
+
+// 回退路径：逐级openat并拒绝任何符号链接（调用方已排除".."分量）
+int PathResolver::walk_nofollow(int dirfd, const std::string& path, int flags, mode_t mode) {
+    int cur = dirfd;
+    size_t start = 0;
+    for (;;) {
+        size_t slash = path.find('/', start);
+        std::string comp = path.substr(start, slash == std::string::npos ? std::string::npos
+                                                                         : slash - start);
+        if (slash == std::string::npos) {
+            int fd = openat(cur, comp.c_str(), flags | O_NOFOLLOW | O_CLOEXEC, mode);
+            int saved = errno;
+            // O_PATH | O_NOFOLLOW会打开符号链接本身，按RESOLVE_NO_SYMLINKS的语义拒绝
+            struct stat st;
+            if (fd >= 0 && (flags & O_PATH) && fstat(fd, &st) == 0 && S_ISLNK(st.st_mode)) {
+                close(fd);
+                fd = -1;
+                saved = ELOOP;
+            }
+            if (cur != dirfd) close(cur);
+            errno = saved;
+            return fd;
+        }
+
+        int next = openat(cur, comp.c_str(), O_PATH | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+        int saved = errno;
+        if (cur != dirfd) close(cur);
+        if (next < 0) {
+            errno = saved;
+            return -1;
+        }
+        cur = next;
+        start = slash + 1;
+    }
+}
+
+// 查找或打开目录fd并放入缓存
+PathResolver::DirFdPtr PathResolver::lookup_dir(const std::string& dir) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = dir_cache_.find(dir);
+        if (it != dir_cache_.end()) {
+            return it->second;
+        }
+    }
+
+    DirFdPtr d = open_dir(dir);
+    if (!d) {
+        return d;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (dir_cache_.size() >= max_cached_) {
+        dir_cache_.clear();
+    }
+    // 并发情况下可能已被其他线程放入，以先放入者为准
+    return dir_cache_.emplace(dir, d).first->second;
+}
+
+// 从最长的已缓存祖先目录出发打开dir，避免重复遍历公共前缀
+PathResolver::DirFdPtr PathResolver::open_dir(const std::string& dir) {
+    DirFdPtr base;
+    size_t split = dir.size();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while ((split = dir.rfind('/', split - 1)) != std::string::npos && split > 0) {
+            auto it = dir_cache_.find(dir.substr(0, split));
+            if (it != dir_cache_.end()) {
+                base = it->second;
+                break;
+            }
+        }
+    }
+
+    int fd;
+    if (base) {
+        fd = open_beneath(base->fd, dir.c_str() + split + 1, O_PATH | O_DIRECTORY, 0);
+    } else {
+        fd = open_beneath(root_fd_, dir.c_str(), O_PATH | O_DIRECTORY, 0);
+    }
+    if (fd < 0) {
+        return DirFdPtr();
+    }
+    return std::make_shared<DirFd>(fd);
+}
+
+int PathResolver::open(const std::string& relpath, int flags, mode_t mode) {
+    if (root_fd_ < 0) {
+        errno = EBADF;
+        return -1;
+    }
+    if (relpath.empty() || relpath.find('\0') != std::string::npos) {
+        errno = EINVAL;
+        return -1;
+    }
+    if (relpath[0] == '/') {
+        errno = EXDEV;
+        return -1;
+    }
+
+    // 规范化：去掉空分量和"."，拒绝".."（"a..b"之类的普通名字允许）
+    std::string norm;
+    norm.reserve(relpath.size());
+    size_t last_slash = std::string::npos;
+    size_t start = 0;
+    while (start <= relpath.size()) {
+        size_t slash = relpath.find('/', start);
+        if (slash == std::string::npos) slash = relpath.size();
+        size_t len = slash - start;
+        if (len == 2 && relpath[start] == '.' && relpath[start + 1] == '.') {
+            errno = EXDEV;
+            return -1;
+        }
+        if (len > 0 && !(len == 1 && relpath[start] == '.')) {
+            if (!norm.empty()) {
+                last_slash = norm.size();
+                norm += '/';
+            }
+            norm.append(relpath, start, len);
+        }
+        start = slash + 1;
+    }
+
+    if (norm.empty()) {
+        // 打开根目录本身
+        return open_beneath(root_fd_, ".", flags, mode);
+    }
+    if (last_slash == std::string::npos) {
+        return open_beneath(root_fd_, norm.c_str(), flags, mode);
+    }
+
+    DirFdPtr dir = lookup_dir(norm.substr(0, last_slash));
+    if (!dir) {
+        return -1;
+    }
+    return open_beneath(dir->fd, norm.c_str() + last_slash + 1, flags, mode);
+}
@@ -0,0 +1,61 @@
+#ifndef PATH_RESOLVER_H
+#define PATH_RESOLVER_H
+
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+#include <cstddef>
+#include <sys/types.h>
+
+// 受限路径解析器
+// 所有路径都相对于构造时指定的根目录打开，保证解析结果不会逃出根目录
+// （包括通过符号链接逃逸）。路径中的任何符号链接都被拒绝，即使它指向根目录内部。
+// 构造时探测openat2(RESOLVE_BENEATH | RESOLVE_NO_SYMLINKS)，可用时使用，
+// 否则（旧内核ENOSYS、seccomp拒绝为EPERM等）逐级openat(O_NOFOLLOW)回退。
+// 热点目录的fd会被缓存，同一目录下的重复打开只需一次单级openat。
+// 注意：目录结构发生重命名/移动后应调用clear_cache()。
+class PathResolver {
+public:
+    // max_cached_dirs为缓存的目录fd上限，超过后清空缓存重新填充
+    explicit PathResolver(const std::string& root, size_t max_cached_dirs = 1024);
+    ~PathResolver();
+
+    PathResolver(const PathResolver&) = delete;
+    PathResolver& operator=(const PathResolver&) = delete;
+
+    // 根目录是否打开成功
+    bool is_open() const { return root_fd_ >= 0; }
+
+    // 在根目录下打开相对路径，返回新fd（调用方负责close），失败返回-1并设置errno
+    // 绝对路径、".."分量、含NUL的路径返回-1(EXDEV/EINVAL)
+    int open(const std::string& relpath, int flags, mode_t mode = 0);
+
+    // 关闭所有缓存的目录fd
+    void clear_cache();
+
+    size_t cached_dirs() const;
+
+private:
+    // 引用计数的目录fd，保证并发清理缓存时仍在使用的fd不被关闭
+    struct DirFd {
+        int fd;
+        explicit DirFd(int f) : fd(f) {}
+        ~DirFd();
+    };
+    typedef std::shared_ptr<DirFd> DirFdPtr;
+
+    DirFdPtr lookup_dir(const std::string& dir);
+    DirFdPtr open_dir(const std::string& dir);
+    int open_beneath(int dirfd, const char* path, int flags, mode_t mode);
+    int walk_nofollow(int dirfd, const std::string& path, int flags, mode_t mode);
+
+    int root_fd_;
+    size_t max_cached_;
+    std::atomic<bool> use_openat2_;
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, DirFdPtr> dir_cache_;
+};
+
+#endif // PATH_RESOLVER_H
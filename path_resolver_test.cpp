@@ -0,0 +1,83 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "path_resolver.h"
+#include "input_validation.h"
+
+using namespace std;
+
+static int g_passed = 0;
+static int g_total = 0;
+
+static void check(const string& name, bool ok) {
+    g_total++;
+    cout << "测试: " << name << " ";
+    if (ok) {
+        cout << "✓ 通过" << endl;
+        g_passed++;
+    } else {
+        cout << "✗ 失败" << endl;
+    }
+}
+
+static bool can_open(PathResolver& r, const string& path) {
+    int fd = r.open(path, O_RDONLY);
+    if (fd < 0) return false;
+    close(fd);
+    return true;
+}
+
+int main() {
+    cout << "=== PathResolver 测试 ===" << endl;
+
+    char tmpl[] = "/tmp/path_resolver_test.XXXXXX";
+    string base = mkdtemp(tmpl);
+    string root = base + "/root";
+    mkdir(root.c_str(), 0755);
+    mkdir((root + "/rec").c_str(), 0755);
+    mkdir((root + "/rec/2024").c_str(), 0755);
+    close(open((root + "/rec/2024/a..b.ts").c_str(), O_CREAT | O_WRONLY, 0644));
+    close(open((root + "/rec/2024/c.ts").c_str(), O_CREAT | O_WRONLY, 0644));
+    close(open((base + "/secret").c_str(), O_CREAT | O_WRONLY, 0644));
+    symlink("../../../secret", (root + "/rec/2024/escape").c_str());
+    symlink("/etc", (root + "/rec/etc").c_str());
+    symlink("2024", (root + "/rec/latest").c_str());
+
+    check("validate_filepath 允许 a..b", validate_filepath("rec/2024/a..b.ts"));
+    check("validate_filepath 拒绝 ..", !validate_filepath("rec/../secret"));
+
+    PathResolver r(root);
+    check("根目录打开", r.is_open());
+    check("普通文件", can_open(r, "rec/2024/a..b.ts"));
+    check("同目录命中缓存", can_open(r, "rec/2024/c.ts") && r.cached_dirs() == 1);
+    check("冗余分量", can_open(r, "./rec//2024/c.ts"));
+    check("父目录缓存复用", can_open(r, "rec/2024") && r.cached_dirs() == 2);
+    check("拒绝 ..", !can_open(r, "rec/../rec/2024/c.ts") && errno == EXDEV);
+    check("拒绝绝对路径", !can_open(r, "/etc/passwd"));
+    check("拒绝符号链接逃逸", !can_open(r, "rec/2024/escape"));
+    check("拒绝绝对符号链接目录", !can_open(r, "rec/etc/passwd"));
+    check("拒绝根目录内的符号链接", !can_open(r, "rec/latest/c.ts") && !can_open(r, "rec/latest"));
+    check("不存在的文件", !can_open(r, "rec/2024/none.ts") && errno == ENOENT);
+
+    int fd = r.open("rec/2024", O_RDONLY | O_DIRECTORY, 0755);
+    check("带mode打开目录", fd >= 0);
+    if (fd >= 0) close(fd);
+
+    fd = r.open("rec/2024/new.ts", O_CREAT | O_WRONLY, 0644);
+    check("创建文件", fd >= 0);
+    if (fd >= 0) close(fd);
+
+    r.clear_cache();
+    check("清空缓存", r.cached_dirs() == 0 && can_open(r, "rec/2024/c.ts"));
+
+    string cmd = "rm -rf '" + base + "'";
+    (void)system(cmd.c_str());
+
+    cout << "\n测试结果: " << g_passed << "/" << g_total << " 通过" << endl;
+    return g_passed == g_total ? 0 : 1;
+}
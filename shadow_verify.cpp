@@ -0,0 +1,131 @@
+#include "shadow_verify.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+shadow_sample_flag g_shadow_sample_every;
+
+// 待比对样本
+struct shadow_sample {
+    shadow_target target;
+    std::string input;
+    std::string fast_result;
+    shadow_reference_fn reference;
+};
+
+// 后台比对状态
+struct shadow_state {
+    std::mutex mutex;
+    std::condition_variable has_work;
+    std::condition_variable idle;
+    std::deque<shadow_sample> queue;
+    size_t capacity = 0;
+    size_t max_recorded = 0;
+    size_t in_flight = 0;               // 已出队但尚未比对完的样本数
+    bool stopping = false;
+    std::thread worker;
+    shadow_stats stats = {};
+    std::vector<shadow_mismatch> recorded;
+};
+
+static shadow_state& state() {
+    static shadow_state* st = new shadow_state();
+    return *st;
+}
+
+static void worker_loop() {
+    shadow_state& st = state();
+    std::unique_lock<std::mutex> lock(st.mutex);
+    for (;;) {
+        st.has_work.wait(lock, [&st] { return st.stopping || !st.queue.empty(); });
+        if (st.queue.empty()) {
+            break;      // stopping且队列已空
+        }
+
+        shadow_sample sample = std::move(st.queue.front());
+        st.queue.pop_front();
+        st.in_flight++;
+
+        // 参考实现在锁外执行
+        lock.unlock();
+        std::string expected = sample.reference(sample.input);
+        lock.lock();
+
+        st.in_flight--;
+        st.stats.checked[sample.target]++;
+        if (expected != sample.fast_result) {
+            st.stats.mismatches[sample.target]++;
+            if (st.recorded.size() < st.max_recorded) {
+                st.recorded.push_back({sample.target, std::move(sample.input),
+                                       std::move(sample.fast_result), std::move(expected)});
+            }
+        }
+        if (st.queue.empty() && st.in_flight == 0) {
+            st.idle.notify_all();
+        }
+    }
+    st.idle.notify_all();
+}
+
+void shadow_enable(unsigned sample_every, size_t queue_capacity, size_t max_recorded) {
+    shadow_state& st = state();
+    {
+        std::lock_guard<std::mutex> lock(st.mutex);
+        st.capacity = queue_capacity;
+        st.max_recorded = max_recorded;
+        if (!st.worker.joinable()) {
+            st.stopping = false;
+            st.worker = std::thread(worker_loop);
+        }
+    }
+    g_shadow_sample_every.every.store(sample_every, std::memory_order_relaxed);
+}
+
+void shadow_disable() {
+    g_shadow_sample_every.every.store(0, std::memory_order_relaxed);
+
+    shadow_state& st = state();
+    std::thread worker;
+    {
+        std::lock_guard<std::mutex> lock(st.mutex);
+        st.stopping = true;
+        worker = std::move(st.worker);
+    }
+    st.has_work.notify_all();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void shadow_flush() {
+    shadow_state& st = state();
+    std::unique_lock<std::mutex> lock(st.mutex);
+    st.idle.wait(lock, [&st] {
+        return (st.queue.empty() && st.in_flight == 0) || !st.worker.joinable();
+    });
+}
+
+void shadow_read(shadow_stats& stats, std::vector<shadow_mismatch>* mismatches) {
+    shadow_state& st = state();
+    std::lock_guard<std::mutex> lock(st.mutex);
+    stats = st.stats;
+    if (mismatches) {
+        *mismatches = st.recorded;
+    }
+}
+
+void shadow_submit(shadow_target target, const std::string& input,
+                   const std::string& fast_result, shadow_reference_fn reference) {
+    shadow_state& st = state();
+    {
+        std::lock_guard<std::mutex> lock(st.mutex);
+        st.stats.sampled[target]++;
+        if (!st.worker.joinable() || st.queue.size() >= st.capacity) {
+            st.stats.dropped++;
+            return;
+        }
+        st.queue.push_back({target, input, fast_result, reference});
+    }
+    st.has_work.notify_one();
+}
@@ -0,0 +1,85 @@
+#ifndef SHADOW_VERIFY_H
+#define SHADOW_VERIFY_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// 影子校验模式
+// 快速路径（SIMD、DFA、缓存等）上线时，按1/N的比例抽样，把输入和快速路径的结果
+// 交给后台线程，用独立的参考实现（ReferenceHostValidator、ReferenceSrtUrlParser）重新计算并比对，
+// 记录不一致的输入。热路径上只做一次计数和入队，队列满时丢弃样本而不阻塞。
+
+// 被校验的函数
+enum shadow_target {
+    SHADOW_IS_VALID_HOST = 0,
+    SHADOW_PARSE_SRT_URL,
+    SHADOW_TARGET_COUNT
+};
+
+// 参考实现：对输入重新计算，返回可比较的结果字符串
+typedef std::string (*shadow_reference_fn)(const std::string& input);
+
+// 一条不一致记录
+struct shadow_mismatch {
+    shadow_target target;
+    std::string input;
+    std::string fast_result;        // 快速路径结果
+    std::string reference_result;   // 参考实现结果
+};
+
+// 统计
+struct shadow_stats {
+    uint64_t sampled[SHADOW_TARGET_COUNT];      // 抽中的调用数
+    uint64_t checked[SHADOW_TARGET_COUNT];      // 后台已比对数
+    uint64_t mismatches[SHADOW_TARGET_COUNT];   // 不一致数
+    uint64_t dropped;                           // 队列满丢弃的样本数
+};
+
+// 开启影子校验：每sample_every次调用抽样一次（1表示全部抽样）
+// queue_capacity为待比对队列上限，max_recorded为保留的不一致记录条数上限
+void shadow_enable(unsigned sample_every, size_t queue_capacity = 4096,
+                   size_t max_recorded = 256);
+
+// 关闭影子校验，等待后台线程处理完已入队样本后退出
+void shadow_disable();
+
+// 等待当前队列中的样本全部比对完成
+void shadow_flush();
+
+// 读取统计，mismatches非空时复制已记录的不一致输入
+void shadow_read(shadow_stats& stats, std::vector<shadow_mismatch>* mismatches = nullptr);
+
+// ===========================================
+// 以下为快速路径埋点使用的内部接口
+// ===========================================
+// 快速路径每次调用都会读取的抽样间隔，0表示关闭。
+// 与metrics_enabled_flag相同，整个结构体占满一个缓存行
+struct alignas(64) shadow_sample_flag {
+    std::atomic<unsigned> every{0};
+};
+static_assert(sizeof(shadow_sample_flag) == 64, "shadow_sample_flag must fill one cache line");
+
+extern shadow_sample_flag g_shadow_sample_every;
+
+// 当前调用是否被抽中；关闭时只有一次relaxed原子读
+inline bool shadow_should_sample() {
+    unsigned every = g_shadow_sample_every.every.load(std::memory_order_relaxed);
+    if (every == 0) {
+        return false;
+    }
+    thread_local unsigned counter = 0;
+    if (++counter < every) {
+        return false;
+    }
+    counter = 0;
+    return true;
+}
+
+// 提交一个样本，由后台线程调用reference(input)并与fast_result比较
+void shadow_submit(shadow_target target, const std::string& input,
+                   const std::string& fast_result, shadow_reference_fn reference);
+
+#endif // SHADOW_VERIFY_H
@@ -0,0 +1,201 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+
+#include "shadow_verify.h"
+#include "host_validator.h"
+#include "srt_url_parser.h"
+
+using namespace std;
+
+static int g_passed = 0;
+static int g_total = 0;
+
+static void check(const string& name, bool ok) {
+    g_total++;
+    cout << "测试: " << name << " ";
+    if (ok) {
+        cout << "✓ 通过" << endl;
+        g_passed++;
+    } else {
+        cout << "✗ 失败" << endl;
+    }
+}
+
+// 与快速路径结果总是不一致的参考实现
+static string disagreeing_reference(const string&) {
+    return "reference";
+}
+
+// 进入后阻塞到g_release为true，用于让后台线程停在比对中
+static atomic<bool> g_entered(false);
+static atomic<bool> g_release(false);
+
+static string blocking_reference(const string& input) {
+    g_entered.store(true);
+    while (!g_release.load()) {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    return input;
+}
+
+// 比对较慢的参考实现，用于检查flush确实等待
+static string slow_reference(const string& input) {
+    this_thread::sleep_for(chrono::milliseconds(50));
+    return input;
+}
+
+static bool has_mismatch(const vector<shadow_mismatch>& recorded, shadow_target target, const string& input) {
+    for (const shadow_mismatch& m : recorded) {
+        if (m.target == target && m.input == input) return true;
+    }
+    return false;
+}
+
+int main() {
+    cout << "=== 影子校验测试 ===" << endl;
+
+    // 统计是累计值，以下都按前后差值检查
+    shadow_stats before, after;
+    vector<shadow_mismatch> recorded;
+
+    check("未开启时不抽样", !shadow_should_sample() && !shadow_should_sample());
+
+    // 1/N抽样：每3次调用抽中1次
+    shadow_enable(3);
+    int sampled = 0;
+    for (int i = 0; i < 9; i++) {
+        if (shadow_should_sample()) sampled++;
+    }
+    check("1/3抽样", sampled == 3);
+
+    // 经过is_valid_host埋点：抽中的调用由参考实现比对，结果一致
+    shadow_read(before);
+    for (int i = 0; i < 9; i++) {
+        is_valid_host(i % 2 ? "example.com" : "bad_host");
+    }
+    shadow_flush();
+    shadow_read(after, &recorded);
+    check("is_valid_host按比例抽样", after.sampled[SHADOW_IS_VALID_HOST] - before.sampled[SHADOW_IS_VALID_HOST] == 3);
+    check("抽中的样本全部比对且一致",
+          after.checked[SHADOW_IS_VALID_HOST] - before.checked[SHADOW_IS_VALID_HOST] == 3 &&
+          after.mismatches[SHADOW_IS_VALID_HOST] == before.mismatches[SHADOW_IS_VALID_HOST] &&
+          recorded.empty());
+
+    // 故意不一致的参考实现：计数和记录的输入
+    shadow_disable();
+    shadow_enable(1, 16, 2);
+    shadow_read(before);
+    shadow_submit(SHADOW_IS_VALID_HOST, "input-a", "fast", disagreeing_reference);
+    shadow_submit(SHADOW_IS_VALID_HOST, "input-b", "fast", disagreeing_reference);
+    shadow_submit(SHADOW_IS_VALID_HOST, "input-c", "fast", disagreeing_reference);
+    shadow_submit(SHADOW_PARSE_SRT_URL, "same", "same", [](const string& s) { return s; });
+    shadow_flush();
+    shadow_read(after, &recorded);
+    check("不一致计数",
+          after.sampled[SHADOW_IS_VALID_HOST] - before.sampled[SHADOW_IS_VALID_HOST] == 3 &&
+          after.checked[SHADOW_IS_VALID_HOST] - before.checked[SHADOW_IS_VALID_HOST] == 3 &&
+          after.mismatches[SHADOW_IS_VALID_HOST] - before.mismatches[SHADOW_IS_VALID_HOST] == 3 &&
+          after.checked[SHADOW_PARSE_SRT_URL] - before.checked[SHADOW_PARSE_SRT_URL] == 1 &&
+          after.mismatches[SHADOW_PARSE_SRT_URL] == before.mismatches[SHADOW_PARSE_SRT_URL] &&
+          after.dropped == before.dropped);
+    check("记录不一致的输入且不超过上限",
+          recorded.size() == 2 && recorded[0].target == SHADOW_IS_VALID_HOST &&
+          recorded[0].input == "input-a" && recorded[0].fast_result == "fast" &&
+          recorded[0].reference_result == "reference" && recorded[1].input == "input-b");
+
+    // 队列满：后台线程卡在第一个样本上，队列容量2，之后的样本被丢弃
+    shadow_disable();
+    shadow_enable(1, 2);
+    shadow_read(before);
+    shadow_submit(SHADOW_IS_VALID_HOST, "blocked", "blocked", blocking_reference);
+    while (!g_entered.load()) {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    for (int i = 0; i < 5; i++) {
+        shadow_submit(SHADOW_IS_VALID_HOST, "queued", "queued", blocking_reference);
+    }
+    shadow_read(after);
+    check("队列满时丢弃样本", after.dropped - before.dropped == 3 &&
+                              after.sampled[SHADOW_IS_VALID_HOST] - before.sampled[SHADOW_IS_VALID_HOST] == 6);
+    g_release.store(true);
+    shadow_flush();
+    shadow_read(after);
+    check("丢弃的样本不比对", after.checked[SHADOW_IS_VALID_HOST] - before.checked[SHADOW_IS_VALID_HOST] == 3);
+
+    // flush等待队列和正在比对的样本全部完成
+    shadow_read(before);
+    for (int i = 0; i < 2; i++) {
+        shadow_submit(SHADOW_PARSE_SRT_URL, "slow", "slow", slow_reference);
+    }
+    shadow_flush();
+    shadow_read(after);
+    check("flush等待比对完成", after.checked[SHADOW_PARSE_SRT_URL] - before.checked[SHADOW_PARSE_SRT_URL] == 2);
+
+    // SRT参考实现按相同规则独立实现：包括[v6]:port、严格整数等快速路径的规则在内，
+    // 各种组合的URL都不应报告不一致
+    shadow_disable();
+    shadow_enable(1, 1 << 16);
+    shadow_read(before);
+    const vector<string> hosts = {"", "example.com", "192.168.1.1", "[2001:db8::1]", "[::ffff:1.2.3.4]",
+                                  "[]", "[1.2.3.4]", "[example.com]", "[fe80::1%eth0]", "[:::]", "[::1",
+                                  "[::1]x", "1.2.3", "01.2.3.4", "256.1.1.1", "a;b", "-bad.com",
+                                  string(260, 'h') + ".com"};
+    const vector<string> ports = {"", ":", ":9000", ":0", ":65536", ":-1", ":+80", ": 80", ":9000abc", ":1e3"};
+    const vector<string> params = {"", "?", "?latency=200&streamid=live", "?latency=120ms", "?latency=-5",
+                                   "?latency=+5", "?latency= 7 ", "?maxbw=99999999999", "?pbkeylen=24&pbkeylen=17",
+                                   "?mode=listener", "?mode=&passphrase=&streamid", "?&&ipttl=64&&", "?=x&conntimeo=3000"};
+    size_t submitted = 0;
+    for (const string& host : hosts) {
+        for (const string& port : ports) {
+            for (const string& param : params) {
+                srt_options opt;
+                parse_srt_url("srt://" + host + port + param, opt);
+                submitted++;
+            }
+        }
+    }
+    const vector<string> extra = {"http://example.com", "srt://", "srt://example.com:9000?" + string(5000, 'x')};
+    for (const string& url : extra) {
+        srt_options opt;
+        parse_srt_url(url, opt);
+        submitted++;
+    }
+    shadow_flush();
+    shadow_read(after, &recorded);
+    for (const shadow_mismatch& m : recorded) {
+        if (m.target == SHADOW_PARSE_SRT_URL) cout << "  不一致: " << m.input << endl;
+    }
+    check("SRT参考实现与快速路径一致",
+          after.checked[SHADOW_PARSE_SRT_URL] - before.checked[SHADOW_PARSE_SRT_URL] == submitted &&
+          after.mismatches[SHADOW_PARSE_SRT_URL] == before.mismatches[SHADOW_PARSE_SRT_URL] &&
+          !has_mismatch(recorded, SHADOW_PARSE_SRT_URL, "srt://[2001:db8::1]:9000") &&
+          !has_mismatch(recorded, SHADOW_PARSE_SRT_URL, "srt://example.com:9000?latency=120ms") &&
+          !has_mismatch(recorded, SHADOW_PARSE_SRT_URL, "srt://example.com:9000abc"));
+
+    // 参考实现的解析结果本身符合当前规则
+    srt_options ref;
+    check("参考实现识别[v6]:port", parse_srt_url_reference("srt://[2001:db8::1]:9000", ref) == 0 &&
+                                   ref.host == "2001:db8::1" && ref.port == 9000 && ref.host_type == HOST_IPV6);
+    check("参考实现严格解析整数", parse_srt_url_reference("srt://example.com:9000abc?latency=120ms", ref) == 0 &&
+                                  ref.port == -1 && ref.latency == -1);
+
+    // 关闭后不再抽样，提交的样本直接丢弃，flush不阻塞
+    shadow_disable();
+    shadow_read(before);
+    bool none = true;
+    for (int i = 0; i < 10; i++) {
+        if (shadow_should_sample()) none = false;
+    }
+    shadow_submit(SHADOW_IS_VALID_HOST, "late", "late", disagreeing_reference);
+    shadow_flush();
+    shadow_read(after);
+    check("关闭后不抽样且丢弃", none && after.dropped - before.dropped == 1 &&
+                                after.checked[SHADOW_IS_VALID_HOST] == before.checked[SHADOW_IS_VALID_HOST]);
+
+    cout << endl << "测试结果: " << g_passed << "/" << g_total << " 通过" << endl;
+    return g_passed == g_total ? 0 : 1;
+}
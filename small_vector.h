@@ -0,0 +1,127 @@
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <cstddef>
+#include <cstring>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+
+// 小容量内联的动态数组
+// 前N个元素存放在对象内部，不分配内存；超过N个时整体搬到堆上。
+// 只用于平凡可复制的元素类型（搬移用memcpy），接口为std::vector的子集
+template <typename T, size_t N>
+class small_vector {
+    static_assert(std::is_trivially_copyable<T>::value, "small_vector只支持平凡可复制类型");
+    static_assert(N > 0, "内联容量不能为0");
+
+public:
+    typedef T value_type;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+
+    small_vector() : data_(inline_), size_(0), capacity_(N) {}
+    ~small_vector() { release(); }
+
+    small_vector(const small_vector& other) : data_(inline_), size_(0), capacity_(N) {
+        assign(other);
+    }
+    small_vector& operator=(const small_vector& other) {
+        if (this != &other) {
+            size_ = 0;
+            assign(other);
+        }
+        return *this;
+    }
+
+    small_vector(small_vector&& other) noexcept : data_(inline_), size_(0), capacity_(N) {
+        take(other);
+    }
+    small_vector& operator=(small_vector&& other) noexcept {
+        if (this != &other) {
+            release();
+            data_ = inline_;
+            size_ = 0;
+            capacity_ = N;
+            take(other);
+        }
+        return *this;
+    }
+
+    void push_back(const T& value) {
+        if (size_ == capacity_) {
+            grow(capacity_ * 2);
+        }
+        data_[size_++] = value;
+    }
+
+    void pop_back() { size_--; }
+    void clear() { size_ = 0; }
+
+    void reserve(size_t n) {
+        if (n > capacity_) grow(n);
+    }
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+    // 元素是否仍在内联存储中（未分配内存）
+    bool is_inline() const { return data_ == inline_; }
+
+    T& operator[](size_t i) { return data_[i]; }
+    const T& operator[](size_t i) const { return data_[i]; }
+    T& back() { return data_[size_ - 1]; }
+    const T& back() const { return data_[size_ - 1]; }
+
+    T* data() { return data_; }
+    const T* data() const { return data_; }
+    iterator begin() { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+
+private:
+    void grow(size_t new_capacity) {
+        T* p = static_cast<T*>(malloc(new_capacity * sizeof(T)));
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        memcpy(static_cast<void*>(p), data_, size_ * sizeof(T));
+        release();
+        data_ = p;
+        capacity_ = new_capacity;
+    }
+
+    void release() {
+        if (data_ != inline_) {
+            free(data_);
+        }
+    }
+
+    void assign(const small_vector& other) {
+        reserve(other.size_);
+        memcpy(static_cast<void*>(data_), other.data_, other.size_ * sizeof(T));
+        size_ = other.size_;
+    }
+
+    // 堆上的数据直接接管指针，内联数据逐字节复制
+    void take(small_vector& other) {
+        if (other.is_inline()) {
+            memcpy(static_cast<void*>(inline_), other.inline_, other.size_ * sizeof(T));
+        } else {
+            data_ = other.data_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inline_;
+            other.capacity_ = N;
+        }
+        size_ = other.size_;
+        other.size_ = 0;
+    }
+
+    T* data_;
+    size_t size_;
+    size_t capacity_;
+    T inline_[N];
+};
+
+#endif // SMALL_VECTOR_H
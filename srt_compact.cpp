@@ -0,0 +1,196 @@
+#include "srt_compact.h"
+#include <cstring>
+
+bool SrtOptionsPool::host_entry::operator==(const host_entry& o) const {
+  return name == o.name && kind == o.kind && memcmp(addr, o.addr, sizeof(addr)) == 0;
+}
+
+size_t SrtOptionsPool::host_entry_hash::operator()(const host_entry& h) const {
+  uint64_t a, b;
+  memcpy(&a, h.addr, 8);
+  memcpy(&b, h.addr + 8, 8);
+  uint64_t x = (static_cast<uint64_t>(h.name) << 8 | static_cast<uint64_t>(h.kind)) ^ a * 0x9E3779B97F4A7C15ULL;
+  x = (x ^ b) * 0xBF58476D1CE4E5B9ULL;
+  return static_cast<size_t>(x ^ (x >> 31));
+}
+
+SrtOptionsPool::SrtOptionsPool() {
+  // id 0 固定为空字符串和空主机
+  strings_.emplace_back();
+  string_index_.emplace(std::string_view(strings_.back()), 0);
+  host_entry empty = {0, HOST_INVALID, {0}};
+  hosts_.push_back(empty);
+  host_index_.emplace(empty, 0);
+}
+
+uint32_t SrtOptionsPool::intern(std::string_view s) {
+  auto it = string_index_.find(s);
+  if (it != string_index_.end()) {
+    return it->second;
+  }
+  uint32_t id = static_cast<uint32_t>(strings_.size());
+  strings_.emplace_back(s);
+  string_index_.emplace(std::string_view(strings_.back()), id);
+  return id;
+}
+
+uint32_t SrtOptionsPool::intern_host(const srt_options& opt) {
+  host_entry key;
+  key.name = intern(opt.host);
+  key.kind = opt.host_type;
+  memcpy(key.addr, opt.host_addr, sizeof(key.addr));
+  auto it = host_index_.find(key);
+  if (it != host_index_.end()) {
+    return it->second;
+  }
+  uint32_t id = static_cast<uint32_t>(hosts_.size());
+  hosts_.push_back(key);
+  host_index_.emplace(key, id);
+  return id;
+}
+
+// 窄字段：-1为未设置，[0, limit]内的值直接保存，其余需要扩展记录
+static bool narrow(int value, int limit, uint8_t bit, uint8_t& flags, int& stored) {
+  if (value == -1) {
+    stored = 0;
+    return true;
+  }
+  if (value < 0 || value > limit) {
+    return false;
+  }
+  stored = value;
+  flags |= bit;
+  return true;
+}
+
+compact_srt_options SrtOptionsPool::compact(const srt_options& opt) {
+  compact_srt_options c;
+  c.host = intern_host(opt);
+  c.streamid = intern(opt.streamid);
+  c.passphrase = intern(opt.passphrase);
+  c.maxbw = opt.maxbw;
+  c.rcvbuf = opt.rcvbuf;
+  c.sndbuf = opt.sndbuf;
+  c.ext = 0;
+  c.flags = 0;
+
+  bool fits = true;
+  if (opt.mode == "caller") {
+    c.mode = SRT_MODE_CALLER;
+  } else if (opt.mode == "listener") {
+    c.mode = SRT_MODE_LISTENER;
+  } else if (opt.mode == "rendezvous") {
+    c.mode = SRT_MODE_RENDEZVOUS;
+  } else {
+    c.mode = SRT_MODE_OTHER;
+    fits = false;
+  }
+
+  int port = 0, pbkeylen = 0, latency = 0, ipttl = 0, conntimeo = 0;
+  fits &= narrow(opt.port, 65535, SRT_HAS_PORT, c.flags, port);
+  fits &= narrow(opt.pbkeylen, 255, SRT_HAS_PBKEYLEN, c.flags, pbkeylen);
+  fits &= narrow(opt.latency, 65535, SRT_HAS_LATENCY, c.flags, latency);
+  fits &= narrow(opt.ipttl, 255, SRT_HAS_IPTTL, c.flags, ipttl);
+  fits &= narrow(opt.conntimeo, 65535, SRT_HAS_CONNTIMEO, c.flags, conntimeo);
+
+  if (fits) {
+    c.port = static_cast<uint16_t>(port);
+    c.pbkeylen = static_cast<uint8_t>(pbkeylen);
+    c.latency = static_cast<uint16_t>(latency);
+    c.ipttl = static_cast<uint8_t>(ipttl);
+    c.conntimeo = static_cast<uint16_t>(conntimeo);
+    return c;
+  }
+
+  // 少见情况：整组窄字段放到扩展记录
+  ext_entry e;
+  e.mode = intern(opt.mode);
+  e.port = opt.port;
+  e.pbkeylen = opt.pbkeylen;
+  e.latency = opt.latency;
+  e.ipttl = opt.ipttl;
+  e.conntimeo = opt.conntimeo;
+  c.ext = static_cast<uint32_t>(exts_.size());
+  exts_.push_back(e);
+  c.flags = SRT_HAS_EXT;
+  c.port = 0;
+  c.pbkeylen = 0;
+  c.latency = 0;
+  c.ipttl = 0;
+  c.conntimeo = 0;
+  return c;
+}
+
+std::string_view SrtOptionsPool::host(const compact_srt_options& c) const {
+  return strings_[hosts_[c.host].name];
+}
+
+host_kind SrtOptionsPool::host_type(const compact_srt_options& c) const {
+  return hosts_[c.host].kind;
+}
+
+const unsigned char* SrtOptionsPool::host_addr(const compact_srt_options& c) const {
+  return hosts_[c.host].addr;
+}
+
+std::string_view SrtOptionsPool::mode(const compact_srt_options& c) const {
+  switch (c.mode) {
+  case SRT_MODE_CALLER:
+    return "caller";
+  case SRT_MODE_LISTENER:
+    return "listener";
+  case SRT_MODE_RENDEZVOUS:
+    return "rendezvous";
+  default:
+    return strings_[exts_[c.ext].mode];
+  }
+}
+
+int SrtOptionsPool::port(const compact_srt_options& c) const {
+  if (c.flags & SRT_HAS_EXT) return exts_[c.ext].port;
+  return (c.flags & SRT_HAS_PORT) ? c.port : -1;
+}
+
+int SrtOptionsPool::pbkeylen(const compact_srt_options& c) const {
+  if (c.flags & SRT_HAS_EXT) return exts_[c.ext].pbkeylen;
+  return (c.flags & SRT_HAS_PBKEYLEN) ? c.pbkeylen : -1;
+}
+
+int SrtOptionsPool::latency(const compact_srt_options& c) const {
+  if (c.flags & SRT_HAS_EXT) return exts_[c.ext].latency;
+  return (c.flags & SRT_HAS_LATENCY) ? c.latency : -1;
+}
+
+int SrtOptionsPool::ipttl(const compact_srt_options& c) const {
+  if (c.flags & SRT_HAS_EXT) return exts_[c.ext].ipttl;
+  return (c.flags & SRT_HAS_IPTTL) ? c.ipttl : -1;
+}
+
+int SrtOptionsPool::conntimeo(const compact_srt_options& c) const {
+  if (c.flags & SRT_HAS_EXT) return exts_[c.ext].conntimeo;
+  return (c.flags & SRT_HAS_CONNTIMEO) ? c.conntimeo : -1;
+}
+
+void SrtOptionsPool::expand(const compact_srt_options& c, srt_options& out) const {
+  out.mode = mode(c);
+  const host_entry& h = hosts_[c.host];
+  out.host = strings_[h.name];
+  out.port = port(c);
+  out.host_type = h.kind;
+  memcpy(out.host_addr, h.addr, sizeof(out.host_addr));
+  out.streamid = strings_[c.streamid];
+  out.passphrase = strings_[c.passphrase];
+  out.pbkeylen = pbkeylen(c);
+  out.latency = latency(c);
+  out.maxbw = c.maxbw;
+  out.rcvbuf = c.rcvbuf;
+  out.sndbuf = c.sndbuf;
+  out.ipttl = ipttl(c);
+  out.conntimeo = conntimeo(c);
+}
+
+srt_options SrtOptionsPool::expand(const compact_srt_options& c) const {
+  srt_options out;
+  expand(c, out);
+  return out;
+}
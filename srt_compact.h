@@ -0,0 +1,128 @@
+#ifndef SRT_COMPACT_H_
+#define SRT_COMPACT_H_
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include "srt_url_parser.h"
+
+// ===========================================
+// 紧凑的SRT选项表示，用于同时保存大量流（10万路以上）的配置
+// 字符串字段驻留在SrtOptionsPool中，记录只保存32位id；
+// 取值范围小的整数用窄类型保存，是否设置由presence位表示（未设置即-1）；
+// 超出窄类型范围的取值和非标准mode整体放到池中的扩展记录，保证与srt_options互相转换无损。
+// 单条记录40字节（srt_options为184字节，且长字符串另有堆分配）
+// ===========================================
+
+// 连接模式
+enum srt_mode : uint8_t {
+  SRT_MODE_CALLER = 0,
+  SRT_MODE_LISTENER,
+  SRT_MODE_RENDEZVOUS,
+  SRT_MODE_OTHER,                     // 其他取值，原文保存在扩展记录中
+};
+
+// presence位
+enum srt_compact_flag : uint8_t {
+  SRT_HAS_PORT      = 1 << 0,
+  SRT_HAS_PBKEYLEN  = 1 << 1,
+  SRT_HAS_LATENCY   = 1 << 2,
+  SRT_HAS_IPTTL     = 1 << 3,
+  SRT_HAS_CONNTIMEO = 1 << 4,
+  SRT_HAS_EXT       = 1 << 7,         // 窄字段或mode放不下，以扩展记录为准
+};
+
+struct compact_srt_options {
+  uint32_t host;                      // 主机记录id（主机名+类型+地址），0表示空主机
+  uint32_t streamid;                  // 字符串id，0表示空字符串
+  uint32_t passphrase;                // 字符串id，0表示空字符串
+  int32_t maxbw;                      // 宽字段原样保存，-1表示默认
+  int32_t rcvbuf;
+  int32_t sndbuf;
+  uint32_t ext;                       // 扩展记录id，仅在SRT_HAS_EXT时有效
+  uint16_t port;                      // 1-65535
+  uint16_t latency;                   // 0-65535毫秒
+  uint16_t conntimeo;                 // 0-65535毫秒
+  uint8_t pbkeylen;                   // 0-255
+  uint8_t ipttl;                      // 0-255
+  srt_mode mode;
+  uint8_t flags;                      // srt_compact_flag的组合
+};
+
+// 紧凑选项的存储池
+// 相同的字符串和主机只保存一份；池不是线程安全的，多线程写入需要外部加锁，
+// 只读访问（expand及各查询函数）可以并发
+class SrtOptionsPool {
+public:
+  SrtOptionsPool();
+
+  SrtOptionsPool(const SrtOptionsPool&) = delete;
+  SrtOptionsPool& operator=(const SrtOptionsPool&) = delete;
+
+  // srt_options -> 紧凑表示
+  compact_srt_options compact(const srt_options& opt);
+
+  // 紧凑表示 -> srt_options，与compact互逆
+  void expand(const compact_srt_options& c, srt_options& out) const;
+  srt_options expand(const compact_srt_options& c) const;
+
+  // 字段查询，取值与expand后的对应字段相同，不构造srt_options
+  std::string_view host(const compact_srt_options& c) const;
+  host_kind host_type(const compact_srt_options& c) const;
+  const unsigned char* host_addr(const compact_srt_options& c) const;
+  std::string_view streamid(const compact_srt_options& c) const { return str(c.streamid); }
+  std::string_view passphrase(const compact_srt_options& c) const { return str(c.passphrase); }
+  std::string_view mode(const compact_srt_options& c) const;
+  int port(const compact_srt_options& c) const;
+  int pbkeylen(const compact_srt_options& c) const;
+  int latency(const compact_srt_options& c) const;
+  int ipttl(const compact_srt_options& c) const;
+  int conntimeo(const compact_srt_options& c) const;
+
+  // 按id取驻留字符串
+  std::string_view str(uint32_t id) const { return strings_[id]; }
+
+  // 池中的字符串、主机和扩展记录数
+  size_t string_count() const { return strings_.size(); }
+  size_t host_count() const { return hosts_.size(); }
+  size_t ext_count() const { return exts_.size(); }
+
+private:
+  // 主机记录，同时作为主机索引的键
+  struct host_entry {
+    uint32_t name;
+    host_kind kind;
+    unsigned char addr[16];
+
+    bool operator==(const host_entry& o) const;
+  };
+  struct host_entry_hash {
+    size_t operator()(const host_entry& h) const;
+  };
+
+  // 扩展记录：窄字段的完整取值和mode原文
+  struct ext_entry {
+    uint32_t mode;
+    int port;
+    int pbkeylen;
+    int latency;
+    int ipttl;
+    int conntimeo;
+  };
+
+  uint32_t intern(std::string_view s);
+  uint32_t intern_host(const srt_options& opt);
+
+  // deque追加元素时不移动已有元素，索引中的string_view保持有效
+  std::deque<std::string> strings_;
+  std::unordered_map<std::string_view, uint32_t> string_index_;
+  std::vector<host_entry> hosts_;
+  std::unordered_map<host_entry, uint32_t, host_entry_hash> host_index_;
+  std::vector<ext_entry> exts_;
+};
+
+#endif  // SRT_COMPACT_H_
@@ -0,0 +1,97 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <cstring>
+
+#include "srt_compact.h"
+
+using namespace std;
+
+static int g_passed = 0;
+static int g_total = 0;
+
+static void check(const string& name, bool ok) {
+    g_total++;
+    cout << "测试: " << name << " ";
+    if (ok) {
+        cout << "✓ 通过" << endl;
+        g_passed++;
+    } else {
+        cout << "✗ 失败" << endl;
+    }
+}
+
+static bool same(const srt_options& a, const srt_options& b) {
+    return a.mode == b.mode && a.host == b.host && a.port == b.port &&
+           a.host_type == b.host_type && memcmp(a.host_addr, b.host_addr, 16) == 0 &&
+           a.streamid == b.streamid && a.passphrase == b.passphrase &&
+           a.pbkeylen == b.pbkeylen && a.latency == b.latency && a.maxbw == b.maxbw &&
+           a.rcvbuf == b.rcvbuf && a.sndbuf == b.sndbuf && a.ipttl == b.ipttl &&
+           a.conntimeo == b.conntimeo;
+}
+
+int main() {
+    cout << "=== 紧凑SRT选项测试 ===" << endl;
+
+    check("单条内存至少缩小3倍", sizeof(compact_srt_options) * 3 <= sizeof(srt_options));
+
+    SrtOptionsPool pool;
+    vector<string> urls = {
+        "srt://cam.example.com:9000?latency=200&streamid=live/cam1&passphrase=secret1234&pbkeylen=16",
+        "srt://[2001:db8::1]:9001?streamid=live/cam2&maxbw=1000000&rcvbuf=12058624",
+        "srt://:9002?mode=listener&latency=120&ipttl=64&conntimeo=3000",
+        "srt://10.0.0.1:9003?mode=rendezvous",
+        "srt://10.0.0.1:9004?mode=caller&streamid=live/cam1",
+    };
+    bool all_same = true;
+    vector<compact_srt_options> table;
+    for (const string& url : urls) {
+        srt_options opt;
+        parse_srt_url(url, opt);
+        compact_srt_options c = pool.compact(opt);
+        table.push_back(c);
+        all_same = all_same && same(opt, pool.expand(c)) && !(c.flags & SRT_HAS_EXT);
+    }
+    check("解析结果往返无损", all_same);
+
+    const compact_srt_options& c0 = table[0];
+    check("字段查询", pool.host(c0) == "cam.example.com" && pool.port(c0) == 9000 &&
+                      pool.latency(c0) == 200 && pool.pbkeylen(c0) == 16 && pool.ipttl(c0) == -1 &&
+                      pool.mode(c0) == "caller" && pool.host_type(c0) == HOST_DOMAIN &&
+                      pool.streamid(c0) == "live/cam1");
+    check("listener空主机", table[2].host == 0 && pool.mode(table[2]) == "listener");
+    check("相同字符串和主机只保存一份", table[0].streamid == table[4].streamid &&
+                                        table[3].host == table[4].host);
+
+    // 超出窄字段范围的取值和非标准mode走扩展记录
+    srt_options odd;
+    parse_srt_url("srt://h.example.com:9000?mode=weird&latency=-5&ipttl=300&conntimeo=100000", odd);
+    compact_srt_options codd = pool.compact(odd);
+    check("扩展记录往返无损", (codd.flags & SRT_HAS_EXT) && same(odd, pool.expand(codd)) &&
+                              pool.mode(codd) == "weird" && pool.latency(codd) == -5);
+
+    // 随机取值往返
+    mt19937 rng(42);
+    const int candidates[] = {-1, 0, 1, 16, 24, 32, 64, 120, 255, 256, 8000, 65535, 65536, -7,
+                              2147483647, -2147483647 - 1};
+    const char* modes[] = {"caller", "listener", "rendezvous", "", "x"};
+    size_t mismatches = 0;
+    for (int i = 0; i < 50000; i++) {
+        srt_options opt;
+        opt.mode = modes[rng() % 5];
+        opt.host = (rng() % 4 == 0) ? "" : "host" + to_string(rng() % 100);
+        opt.host_type = static_cast<host_kind>(rng() % 4);
+        for (int j = 0; j < 16; j++) opt.host_addr[j] = static_cast<unsigned char>(rng() % 3);
+        opt.streamid = "s" + to_string(rng() % 1000);
+        opt.passphrase = (rng() % 2) ? "" : "pass" + to_string(rng() % 10);
+        int* ints[] = {&opt.port, &opt.pbkeylen, &opt.latency, &opt.maxbw, &opt.rcvbuf,
+                       &opt.sndbuf, &opt.ipttl, &opt.conntimeo};
+        for (int* f : ints) *f = candidates[rng() % (sizeof(candidates) / sizeof(candidates[0]))];
+        if (!same(opt, pool.expand(pool.compact(opt)))) mismatches++;
+    }
+    check("随机取值往返无损", mismatches == 0);
+
+    cout << endl << "测试结果: " << g_passed << "/" << g_total << " 通过" << endl;
+    return g_passed == g_total ? 0 : 1;
+}
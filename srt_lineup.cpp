@@ -0,0 +1,174 @@
+#include "srt_lineup.h"
+#include <fstream>
+#include <sstream>
+#include <cstring>
+
+uint32_t srt_options_diff(const srt_options& a, const srt_options& b) {
+  uint32_t fields = 0;
+  if (a.mode != b.mode) fields |= SRT_FIELD_MODE;
+  if (a.host != b.host || a.host_type != b.host_type ||
+      memcmp(a.host_addr, b.host_addr, sizeof(a.host_addr)) != 0) {
+    fields |= SRT_FIELD_HOST;
+  }
+  if (a.port != b.port) fields |= SRT_FIELD_PORT;
+  if (a.streamid != b.streamid) fields |= SRT_FIELD_STREAMID;
+  if (a.passphrase != b.passphrase) fields |= SRT_FIELD_PASSPHRASE;
+  if (a.pbkeylen != b.pbkeylen) fields |= SRT_FIELD_PBKEYLEN;
+  if (a.latency != b.latency) fields |= SRT_FIELD_LATENCY;
+  if (a.maxbw != b.maxbw) fields |= SRT_FIELD_MAXBW;
+  if (a.rcvbuf != b.rcvbuf) fields |= SRT_FIELD_RCVBUF;
+  if (a.sndbuf != b.sndbuf) fields |= SRT_FIELD_SNDBUF;
+  if (a.ipttl != b.ipttl) fields |= SRT_FIELD_IPTTL;
+  if (a.conntimeo != b.conntimeo) fields |= SRT_FIELD_CONNTIMEO;
+  return fields;
+}
+
+const lineup_entry* lineup_table::find(std::string_view key) const {
+  auto it = by_key.find(key);
+  return it == by_key.end() ? nullptr : entries[it->second].get();
+}
+
+// FNV-1a 64位哈希
+static uint64_t line_hash(std::string_view line) {
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (char c : line) {
+    h ^= static_cast<unsigned char>(c);
+    h *= 0x100000001b3ULL;
+  }
+  return h;
+}
+
+static bool is_blank(char c) {
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+static std::string_view trim(std::string_view s) {
+  while (!s.empty() && is_blank(s.front())) s.remove_prefix(1);
+  while (!s.empty() && is_blank(s.back())) s.remove_suffix(1);
+  return s;
+}
+
+// 解析一行，生成新条目；失败时返回空指针并填写错误
+static lineup_entry_ptr parse_line(std::string_view line, uint64_t hash, size_t line_no,
+                                   std::vector<lineup_error>& errors) {
+  std::string_view name;
+  std::string_view url = line;
+  if (line.compare(0, 6, "srt://") != 0) {
+    size_t sp = 0;
+    while (sp < line.size() && !is_blank(line[sp])) sp++;
+    name = line.substr(0, sp);
+    url = trim(line.substr(sp));
+  }
+
+  auto entry = std::make_shared<lineup_entry>();
+  if (url.empty() || parse_srt_url(std::string(url), entry->opt) != 0) {
+    errors.push_back({line_no, "invalid srt url"});
+    return nullptr;
+  }
+  if (!name.empty()) {
+    entry->key = name;
+  } else if (!entry->opt.streamid.empty()) {
+    entry->key = entry->opt.streamid;
+  } else {
+    entry->key = url;
+  }
+  entry->line = line;
+  entry->hash = hash;
+  return entry;
+}
+
+SrtLineup::SrtLineup() : table_(std::make_shared<lineup_table>()) {
+}
+
+std::shared_ptr<const lineup_table> SrtLineup::snapshot() const {
+  std::lock_guard<std::mutex> lock(publish_mutex_);
+  return table_;
+}
+
+bool SrtLineup::reload(std::string_view text, lineup_changes& result) {
+  result.changes.clear();
+  result.errors.clear();
+  result.reparsed = 0;
+  result.reused = 0;
+
+  std::lock_guard<std::mutex> lock(reload_mutex_);
+  std::shared_ptr<const lineup_table> old = snapshot();
+
+  auto table = std::make_shared<lineup_table>();
+  table->generation = old->generation + 1;
+
+  // 逐行：哈希命中且文本相同的行复用旧条目，其余重新解析
+  size_t line_no = 0;
+  size_t pos = 0;
+  while (pos < text.size()) {
+    size_t nl = text.find('\n', pos);
+    if (nl == std::string_view::npos) nl = text.size();
+    std::string_view line = trim(text.substr(pos, nl - pos));
+    pos = nl + 1;
+    line_no++;
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+
+    uint64_t hash = line_hash(line);
+    lineup_entry_ptr entry;
+    auto hit = old->by_hash.find(hash);
+    if (hit != old->by_hash.end() && old->entries[hit->second]->line == line) {
+      entry = old->entries[hit->second];
+      result.reused++;
+    } else {
+      entry = parse_line(line, hash, line_no, result.errors);
+      result.reparsed++;
+      if (!entry) continue;
+    }
+
+    size_t index = table->entries.size();
+    if (!table->by_key.emplace(std::string_view(entry->key), index).second) {
+      result.errors.push_back({line_no, "duplicate stream key: " + entry->key});
+      continue;
+    }
+    table->by_hash.emplace(hash, index);
+    table->entries.push_back(std::move(entry));
+  }
+
+  if (!result.errors.empty()) {
+    return false;
+  }
+
+  // 变更集：新增/改动按新表顺序，删除按旧表顺序
+  for (const lineup_entry_ptr& entry : table->entries) {
+    const lineup_entry* before = old->find(entry->key);
+    if (before == nullptr) {
+      result.changes.push_back({LINEUP_ADDED, entry->key, 0, nullptr, entry});
+    } else if (before != entry.get()) {
+      uint32_t fields = srt_options_diff(before->opt, entry->opt);
+      if (fields != 0) {
+        result.changes.push_back({LINEUP_MODIFIED, entry->key, fields,
+                                  old->entries[old->by_key.at(entry->key)], entry});
+      }
+    }
+  }
+  for (const lineup_entry_ptr& entry : old->entries) {
+    if (table->by_key.find(entry->key) == table->by_key.end()) {
+      result.changes.push_back({LINEUP_REMOVED, entry->key, 0, entry, nullptr});
+    }
+  }
+
+  std::lock_guard<std::mutex> publish_lock(publish_mutex_);
+  table_ = std::move(table);
+  return true;
+}
+
+bool SrtLineup::reload_file(const std::string& path, lineup_changes& result) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    result.changes.clear();
+    result.errors.assign(1, lineup_error{0, "cannot open " + path});
+    result.reparsed = 0;
+    result.reused = 0;
+    return false;
+  }
+  std::ostringstream ss;
+  ss << in.rdbuf();
+  return reload(ss.str(), result);
+}
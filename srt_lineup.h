@@ -0,0 +1,114 @@
+#ifndef SRT_LINEUP_H_
+#define SRT_LINEUP_H_
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include "srt_url_parser.h"
+
+// ===========================================
+// SRT节目单（lineup）的增量热加载
+// 节目单每行一路流：  [名字 空白] srt://...
+// 空行和'#'开头的行忽略。有名字时以名字标识流，否则以streamid标识，streamid为空时以URL本身标识。
+// 重新加载时按行哈希，只重新解析新增或改动的行，未改动的行直接复用上一版的解析结果；
+// 新表构建完成后整体替换，读者持有的旧表在释放前保持有效。
+// ===========================================
+
+// srt_options字段位，用于描述改动了哪些字段
+enum srt_field {
+  SRT_FIELD_MODE       = 1 << 0,
+  SRT_FIELD_HOST       = 1 << 1,      // host、host_type、host_addr
+  SRT_FIELD_PORT       = 1 << 2,
+  SRT_FIELD_STREAMID   = 1 << 3,
+  SRT_FIELD_PASSPHRASE = 1 << 4,
+  SRT_FIELD_PBKEYLEN   = 1 << 5,
+  SRT_FIELD_LATENCY    = 1 << 6,
+  SRT_FIELD_MAXBW      = 1 << 7,
+  SRT_FIELD_RCVBUF     = 1 << 8,
+  SRT_FIELD_SNDBUF     = 1 << 9,
+  SRT_FIELD_IPTTL      = 1 << 10,
+  SRT_FIELD_CONNTIMEO  = 1 << 11,
+};
+
+// 比较两组选项，返回取值不同的srt_field位
+uint32_t srt_options_diff(const srt_options& a, const srt_options& b);
+
+// 节目单中的一路流（加载后不可变，新旧两版之间共享）
+struct lineup_entry {
+  std::string key;                    // 流标识
+  std::string line;                   // 去掉首尾空白后的原始行
+  uint64_t hash;                      // line的哈希
+  srt_options opt;
+};
+
+typedef std::shared_ptr<const lineup_entry> lineup_entry_ptr;
+
+// 某一版节目单
+struct lineup_table {
+  uint64_t generation;
+  std::vector<lineup_entry_ptr> entries;                      // 按行序
+  std::unordered_map<std::string_view, size_t> by_key;        // 键指向entries中的key
+  std::unordered_map<uint64_t, size_t> by_hash;               // 行哈希 -> entries下标
+
+  const lineup_entry* find(std::string_view key) const;
+};
+
+// 一条变更
+enum lineup_change_kind {
+  LINEUP_ADDED = 0,
+  LINEUP_REMOVED,
+  LINEUP_MODIFIED,
+};
+
+struct lineup_change {
+  lineup_change_kind kind;
+  std::string key;
+  uint32_t fields;                    // LINEUP_MODIFIED时为改动的srt_field位，其余为0
+  lineup_entry_ptr before;            // LINEUP_ADDED时为空
+  lineup_entry_ptr after;             // LINEUP_REMOVED时为空
+};
+
+// 加载错误
+struct lineup_error {
+  size_t line_no;                     // 行号（从1开始）
+  std::string message;
+};
+
+// 一次加载的结果
+struct lineup_changes {
+  std::vector<lineup_change> changes;
+  std::vector<lineup_error> errors;
+  size_t reparsed;                    // 重新解析的行数
+  size_t reused;                      // 复用上一版结果的行数
+};
+
+class SrtLineup {
+public:
+  SrtLineup();
+
+  SrtLineup(const SrtLineup&) = delete;
+  SrtLineup& operator=(const SrtLineup&) = delete;
+
+  // 加载新版节目单文本，计算变更并替换当前表
+  // 任一行解析失败或流标识重复时返回false，errors中给出原因，当前表保持不变
+  // 只改动了参数顺序、空白等而解析结果相同的行不计入changes
+  bool reload(std::string_view text, lineup_changes& result);
+
+  // 从文件加载，读取失败时返回false
+  bool reload_file(const std::string& path, lineup_changes& result);
+
+  // 当前表；返回的指针在调用方释放前一直有效，不受之后的reload影响
+  std::shared_ptr<const lineup_table> snapshot() const;
+
+private:
+  std::mutex reload_mutex_;           // 串行化reload
+  mutable std::mutex publish_mutex_;  // 保护table_指针本身
+  std::shared_ptr<const lineup_table> table_;
+};
+
+#endif  // SRT_LINEUP_H_
@@ -0,0 +1,89 @@
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "srt_lineup.h"
+
+using namespace std;
+
+static int g_passed = 0;
+static int g_total = 0;
+
+static void check(const string& name, bool ok) {
+    g_total++;
+    cout << "测试: " << name << " ";
+    if (ok) {
+        cout << "✓ 通过" << endl;
+        g_passed++;
+    } else {
+        cout << "✗ 失败" << endl;
+    }
+}
+
+static size_t count_kind(const lineup_changes& r, lineup_change_kind kind) {
+    size_t n = 0;
+    for (const lineup_change& c : r.changes) {
+        if (c.kind == kind) n++;
+    }
+    return n;
+}
+
+int main() {
+    cout << "=== SRT节目单热加载测试 ===" << endl;
+
+    SrtLineup lineup;
+    lineup_changes r;
+
+    string v1 =
+        "# 节目单\n"
+        "news   srt://10.0.0.1:9000?latency=200\n"
+        "sports srt://10.0.0.2:9000?latency=200&maxbw=1000\n"
+        "\n"
+        "srt://cam.example.com:9001?streamid=live/cam1\n";
+    bool ok = lineup.reload(v1, r);
+    check("首次加载", ok && r.changes.size() == 3 && count_kind(r, LINEUP_ADDED) == 3 &&
+                      r.reparsed == 3 && r.reused == 0);
+
+    shared_ptr<const lineup_table> t1 = lineup.snapshot();
+    check("按名字和streamid查找", t1->find("news") && t1->find("live/cam1") &&
+                                  t1->find("news")->opt.port == 9000 && !t1->find("nope"));
+
+    ok = lineup.reload(v1, r);
+    check("内容不变时不重新解析", ok && r.changes.empty() && r.reparsed == 0 && r.reused == 3);
+
+    string v2 =
+        "sports srt://10.0.0.2:9000?maxbw=1000&latency=200\n"           // 只调换参数顺序
+        "news   srt://10.0.0.1:9000?latency=400\n"                      // 改动latency
+        "srt://cam.example.com:9001?streamid=live/cam1\n"
+        "movies srt://10.0.0.3:9000\n";                                 // 新增
+    ok = lineup.reload(v2, r);
+    check("只重新解析改动的行", ok && r.reparsed == 3 && r.reused == 1);
+    check("变更集", r.changes.size() == 2 && count_kind(r, LINEUP_MODIFIED) == 1 &&
+                    count_kind(r, LINEUP_ADDED) == 1);
+    for (const lineup_change& c : r.changes) {
+        if (c.kind == LINEUP_MODIFIED) {
+            check("字段级差异", c.key == "news" && c.fields == SRT_FIELD_LATENCY &&
+                                c.before->opt.latency == 200 && c.after->opt.latency == 400);
+        }
+    }
+    check("旧快照保持不变", t1->find("news")->opt.latency == 200 && !t1->find("movies"));
+    check("新快照已替换", lineup.snapshot()->find("news")->opt.latency == 400 &&
+                          lineup.snapshot()->generation == t1->generation + 2);
+
+    string v3 =
+        "news   srt://10.0.0.9:9000?latency=400\n"
+        "srt://cam.example.com:9001?streamid=live/cam1\n";
+    ok = lineup.reload(v3, r);
+    check("删除和主机改动", ok && count_kind(r, LINEUP_REMOVED) == 2 &&
+                            count_kind(r, LINEUP_MODIFIED) == 1 && r.changes[0].fields == SRT_FIELD_HOST);
+
+    shared_ptr<const lineup_table> t3 = lineup.snapshot();
+    ok = lineup.reload("news srt://10.0.0.9:9000\nbad srt://a;b:9000\nnews srt://1.1.1.1:1\n", r);
+    check("错误时整体拒绝", !ok && r.errors.size() == 2 && r.errors[0].line_no == 2 &&
+                            r.errors[1].line_no == 3 && lineup.snapshot() == t3);
+
+    check("文件不存在", !lineup.reload_file("/nonexistent/lineup.txt", r) && r.errors.size() == 1);
+
+    cout << endl << "测试结果: " << g_passed << "/" << g_total << " 通过" << endl;
+    return g_passed == g_total ? 0 : 1;
+}
@@ -0,0 +1,86 @@
+#include "srt_streamid.h"
+
+static constexpr std::string_view STREAMID_PREFIX = "#!::";
+
+// 标准键按"rmusht"顺序对应的字段
+static std::string_view srt_streamid::* const STANDARD_FIELDS[] = {
+  &srt_streamid::resource, &srt_streamid::mode, &srt_streamid::user,
+  &srt_streamid::session, &srt_streamid::host, &srt_streamid::type,
+};
+static constexpr std::string_view STANDARD_KEYS = "rmusht";
+
+// 标准键的下标，非标准键返回-1
+static int standard_index(std::string_view key) {
+  if (key.size() != 1) {
+    return -1;
+  }
+  size_t i = STANDARD_KEYS.find(key[0]);
+  return i == std::string_view::npos ? -1 : static_cast<int>(i);
+}
+
+std::string_view srt_streamid::get(std::string_view key) const {
+  int index = standard_index(key);
+  if (index >= 0) {
+    return this->*STANDARD_FIELDS[index];
+  }
+  for (const srt_streamid_pair& p : custom) {
+    if (p.key == key) {
+      return p.value;
+    }
+  }
+  return std::string_view();
+}
+
+bool parse_srt_streamid(std::string_view streamid, srt_streamid& out) {
+  out.resource = out.mode = out.user = out.session = out.host = out.type = std::string_view();
+  out.custom.clear();
+  out.structured = false;
+
+  // 长度上限同时限制了自定义键的个数，查重的二次扫描因此有固定上界
+  if (streamid.size() > SRT_STREAMID_MAX_LENGTH) {
+    return false;
+  }
+
+  // 快速路径：普通streamid整体作为资源名
+  if (streamid.compare(0, STREAMID_PREFIX.size(), STREAMID_PREFIX) != 0) {
+    out.resource = streamid;
+    return true;
+  }
+  out.structured = true;
+
+  // 标准键是否已出现，用于检测重复
+  unsigned seen = 0;
+  std::string_view body = streamid.substr(STREAMID_PREFIX.size());
+  size_t start = 0;
+  while (start <= body.size()) {
+    size_t comma = body.find(',', start);
+    if (comma == std::string_view::npos) comma = body.size();
+    std::string_view item = body.substr(start, comma - start);
+    start = comma + 1;
+
+    size_t eq = item.find('=');
+    if (eq == std::string_view::npos || eq == 0) {
+      return false;
+    }
+    std::string_view key = item.substr(0, eq);
+    std::string_view value = item.substr(eq + 1);
+
+    int index = standard_index(key);
+    if (index >= 0) {
+      unsigned bit = 1u << index;
+      if (seen & bit) {
+        return false;
+      }
+      seen |= bit;
+      out.*STANDARD_FIELDS[index] = value;
+      continue;
+    }
+    for (const srt_streamid_pair& p : out.custom) {
+      if (p.key == key) {
+        return false;
+      }
+    }
+    out.custom.push_back(srt_streamid_pair{key, value});
+  }
+  return true;
+}
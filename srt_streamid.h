@@ -0,0 +1,47 @@
+#ifndef SRT_STREAMID_H_
+#define SRT_STREAMID_H_
+
+#include <string_view>
+#include "small_vector.h"
+#include "srt_url_parser.h"
+
+// ===========================================
+// SRT访问控制streamid解析
+// 格式：#!::r=live/cam1,m=publish,u=alice,s=abc123,h=example.com,t=stream,自定义键=值
+// 所有字段都是指向原字符串的string_view，解析不分配内存（自定义键不超过4个时）
+// ===========================================
+
+// 自定义键值对
+struct srt_streamid_pair {
+  std::string_view key;
+  std::string_view value;
+};
+
+struct srt_streamid {
+  bool structured;                    // 是否为#!::格式
+  std::string_view resource;          // r：资源名；非#!::格式时为整个streamid
+  std::string_view mode;              // m：request/publish/bidirectional
+  std::string_view user;              // u：用户名
+  std::string_view session;           // s：会话标识
+  std::string_view host;              // h：主机名
+  std::string_view type;              // t：stream/file/auth
+  small_vector<srt_streamid_pair, 4> custom;   // 其他键，按出现顺序
+
+  // 按键查找（标准键和自定义键都可以），不存在时返回空
+  std::string_view get(std::string_view key) const;
+};
+
+// streamid长度上限，与SRT库的SRTO_STREAMID限制一致
+const size_t SRT_STREAMID_MAX_LENGTH = 512;
+
+// 解析streamid，返回的string_view指向streamid本身
+// 不以"#!::"开头时走快速路径：structured为false，resource为整个streamid
+// 超过SRT_STREAMID_MAX_LENGTH，或#!::格式中出现空键、缺少'='或重复的键时返回false
+bool parse_srt_streamid(std::string_view streamid, srt_streamid& out);
+
+// 解析srt_options中的streamid，结果在opt存活且未修改期间有效
+inline bool parse_srt_streamid(const srt_options& opt, srt_streamid& out) {
+  return parse_srt_streamid(std::string_view(opt.streamid), out);
+}
+
+#endif  // SRT_STREAMID_H_
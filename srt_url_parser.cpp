@@ -1,13 +1,20 @@
-#include <sstream>
 #include <algorithm>
 #include <cctype>
-#include <vector>
 #include <string>
+#include <string_view>
+#include <sstream>
+#include <stdexcept>
 #include <cstdio>
+#include <arpa/inet.h>
 #include "srt_url_parser.h"
+#include "parse_int.h"
+#include "validation_metrics.h"
+#include "shadow_verify.h"
 
 // ===========================================
 // 内部辅助类：SRT URL解析器
+// 内部全部基于std::string_view，只在写入选项字段时复制，
+// 选项类型为模板参数，srt_options与pmr_srt_options共用同一套逻辑
 // ===========================================
 class SrtUrlParserHelper {
 public:
@@ -15,7 +22,8 @@ public:
   ~SrtUrlParserHelper() = default;
   
   // 解析URL并填充选项结构体
-  int parse(const std::string& srt_url, srt_options& opt) {
+  template <typename Options>
+  int parse(std::string_view srt_url, Options& opt) {
     // 1. 初始化默认值
     init_default_options(opt);
     
@@ -25,7 +33,7 @@ public:
     }
     
     // 3. 分离URL各部分
-    std::string main_part, param_part;
+    std::string_view main_part, param_part;
     if (!split_url_parts(srt_url, main_part, param_part)) {
       return -1;
     }
@@ -45,15 +53,88 @@ public:
     // 6. 后处理验证
     return post_process_validation(opt);
   }
+  
+  // 解析连接组URL：成员列表 + 整组共用参数
+  int parse_group(std::string_view srt_url, srt_group_options& group) {
+    group.type = SRT_GROUP_BROADCAST;
+    group.members.clear();
+    init_default_options(group.common);
+    
+    if (!validate_url_format(srt_url)) {
+      return -1;
+    }
+    
+    std::string_view main_part, param_part;
+    if (!split_url_parts(srt_url, main_part, param_part)) {
+      return -1;
+    }
+    if (main_part.empty()) {
+      metrics_note_reject(REJECT_EMPTY);
+      return -1;
+    }
+    
+    // 逐个解析成员，每个成员在此完成全部校验
+    size_t start = 0;
+    for (;;) {
+      size_t comma = main_part.find(',', start);
+      if (comma == std::string_view::npos) comma = main_part.size();
+      srt_group_member member;
+      if (!parse_group_member(main_part.substr(start, comma - start), member)) {
+        group.members.clear();
+        return -1;
+      }
+      group.members.push_back(member);
+      if (comma == main_part.size()) break;
+      start = comma + 1;
+    }
+    
+    bool type_ok = true;
+    if (!param_part.empty()) {
+      parse_parameters(param_part, group.common, [&](std::string_view key, std::string_view value) {
+        if (key != "grouptype") {
+          return false;
+        }
+        if (value == "broadcast") {
+          group.type = SRT_GROUP_BROADCAST;
+        } else if (value == "backup") {
+          group.type = SRT_GROUP_BACKUP;
+        } else if (value == "balancing") {
+          group.type = SRT_GROUP_BALANCING;
+        } else {
+          type_ok = false;
+        }
+        return true;
+      });
+    }
+    if (!type_ok) {
+      metrics_note_reject(REJECT_BAD_FORMAT);
+      group.members.clear();
+      return -1;
+    }
+    
+    post_process_validation(group.common);
+    
+    // 连接组只在caller端建立
+    if (group.common.mode != "caller") {
+      metrics_note_reject(REJECT_BAD_FORMAT);
+      group.members.clear();
+      return -1;
+    }
+    return 0;
+  }
 
 private:
+  static constexpr std::string_view SRT_PREFIX = "srt://";
+
   // 初始化默认值
-  void init_default_options(srt_options& opt) {
+  template <typename Options>
+  void init_default_options(Options& opt) {
     opt.mode = "caller";        // 默认caller模式
-    opt.host = "";              // 默认空主机
+    opt.host.clear();           // 默认空主机
     opt.port = -1;              // 默认端口
-    opt.streamid = "";          // 默认空流ID
-    opt.passphrase = "";        // 默认无加密
+    clear_host(opt);            // 默认无主机类型和地址
+    opt.streamid.clear();       // 默认空流ID
+    opt.passphrase.clear();     // 默认无加密
     opt.pbkeylen = -1;          // 默认密钥长度
     opt.latency = -1;           // 默认延迟
     opt.maxbw = -1;             // 默认无带宽限制
@@ -63,20 +144,28 @@ private:
     opt.conntimeo = -1;         // 默认连接超时
   }
   
-  // 验证URL格式
-  bool validate_url_format(const std::string& url) {
+  // 验证URL格式，失败时记录拒绝原因
+  bool validate_url_format(std::string_view url) {
     if (url.empty()) {
+      metrics_note_reject(REJECT_EMPTY);
+      return false;
+    }
+    
+    // 总长度上限，后续所有步骤都是线性扫描，最坏耗时因此有固定上界
+    if (url.length() > SRT_URL_MAX_LENGTH) {
+      metrics_note_reject(REJECT_TOO_LONG);
       return false;
     }
     
     // 检查是否以srt://开头
-    const std::string srt_prefix = "srt://";
-    if (url.find(srt_prefix) != 0) {
+    if (url.compare(0, SRT_PREFIX.length(), SRT_PREFIX) != 0) {
+      metrics_note_reject(REJECT_BAD_SCHEME);
       return false;
     }
     
     // 基本长度检查
-    if (url.length() <= srt_prefix.length()) {
+    if (url.length() <= SRT_PREFIX.length()) {
+      metrics_note_reject(REJECT_BAD_SCHEME);
       return false;
     }
     
@@ -84,82 +173,220 @@ private:
   }
   
   // 分离URL的主体部分和参数部分
-  bool split_url_parts(const std::string& url, std::string& main_part, std::string& param_part) {
+  bool split_url_parts(std::string_view url, std::string_view& main_part,
+                       std::string_view& param_part) {
     // 移除srt://前缀
-    const std::string srt_prefix = "srt://";
-    std::string url_body = url.substr(srt_prefix.length());
+    std::string_view url_body = url.substr(SRT_PREFIX.length());
     
     // 查找参数分隔符?
     size_t question_pos = url_body.find('?');
-    if (question_pos != std::string::npos) {
+    if (question_pos != std::string_view::npos) {
       main_part = url_body.substr(0, question_pos);
       param_part = url_body.substr(question_pos + 1);
     } else {
       main_part = url_body;
-      param_part = "";
+      param_part = std::string_view();
     }
     
     return true;
   }
   
-  // 解析主体部分(host:port)
-  bool parse_main_part(const std::string& main_part, srt_options& opt) {
+  // 清空主机类型和二进制地址
+  template <typename Options>
+  void clear_host(Options& opt) {
+    opt.host_type = HOST_INVALID;
+    std::fill(opt.host_addr, opt.host_addr + sizeof(opt.host_addr), 0);
+  }
+  
+  // 拆分host:port，支持RFC 3986的IPv6字面量写法 [v6]:port
+  bool split_host_port(std::string_view main_part, std::string_view& host,
+                       std::string_view& port_str, bool& bracketed) {
+    host = std::string_view();
+    port_str = std::string_view();
+    bracketed = (!main_part.empty() && main_part[0] == '[');
+    if (bracketed) {
+      // [v6]或[v6]:port
+      size_t close_pos = main_part.find(']');
+      if (close_pos == std::string_view::npos) {
+        metrics_note_reject(REJECT_BAD_FORMAT);
+        return false;
+      }
+      host = main_part.substr(1, close_pos - 1);
+      std::string_view rest = main_part.substr(close_pos + 1);
+      if (!rest.empty()) {
+        if (rest[0] != ':') {
+          metrics_note_reject(REJECT_BAD_FORMAT);
+          return false;
+        }
+        port_str = rest.substr(1);
+      }
+    } else {
+      // 查找端口分隔符:
+      size_t colon_pos = main_part.find(':');
+      if (colon_pos != std::string_view::npos) {
+        host = main_part.substr(0, colon_pos);
+        port_str = main_part.substr(colon_pos + 1);
+      } else {
+        // 没有端口号，只有主机
+        host = main_part;
+      }
+    }
+    return true;
+  }
+  
+  // 校验非空主机，写入类型和二进制地址；方括号内只允许IPv6
+  template <typename Target>
+  bool classify_into(std::string_view host, bool bracketed, Target& target) {
+    target.host_type = classify_host(host, target.host_addr);
+    if (target.host_type == HOST_INVALID || (bracketed && target.host_type != HOST_IPV6)) {
+      clear_host(target);
+      return false;
+    }
+    return true;
+  }
+  
+  // 解析主体部分(host:port)，并在同一次解析中校验主机
+  template <typename Options>
+  bool parse_main_part(std::string_view main_part, Options& opt) {
     if (main_part.empty()) {
       // 空主体，可能是listener模式
-      opt.host = "";
+      opt.host.clear();
       opt.port = -1;
       return true;
     }
     
-    // 查找端口分隔符:
-    size_t colon_pos = main_part.find(':');
-    if (colon_pos != std::string::npos) {
-      // 有端口号
-      opt.host = main_part.substr(0, colon_pos);
-      std::string port_str = main_part.substr(colon_pos + 1);
-      
-      if (!port_str.empty()) {
-        opt.port = string_to_int(port_str, -1);
-        if (opt.port <= 0 || opt.port > 65535) {
-          // 端口号无效，使用默认值
-          opt.port = -1;
-        }
+    std::string_view host;
+    std::string_view port_str;
+    bool bracketed;
+    if (!split_host_port(main_part, host, port_str, bracketed)) {
+      return false;
+    }
+    
+    // 校验主机并取得类型和二进制地址，调用方无需再次调用is_valid_host
+    if (!host.empty()) {
+      if (!classify_into(host, bracketed, opt)) {
+        return false;
       }
-    } else {
-      // 没有端口号，只有主机
-      opt.host = main_part;
-      opt.port = -1;
+    } else if (bracketed) {
+      metrics_note_reject(REJECT_EMPTY);
+      return false;
+    }
+    opt.host = host;
+    
+    opt.port = -1;
+    if (!port_str.empty()) {
+      int port;
+      if (parse_int(port_str, port, 1, 65535) == PARSE_INT_OK) {
+        opt.port = port;
+      }
+      // 端口号无效，使用默认值
     }
     
     return true;
   }
   
-  // 解析参数部分
-  bool parse_parameters(const std::string& param_part, srt_options& opt) {
-    std::vector<std::string> param_pairs = split_string(param_part, '&');
+  // 解析单个组成员：host:port[;weight=N][;priority=N]
+  // 成员必须有主机和有效端口，属性未知或取值无效都视为错误
+  bool parse_group_member(std::string_view text, srt_group_member& member) {
+    member.host = std::string_view();
+    member.port = -1;
+    clear_host(member);
+    member.weight = -1;
+    member.priority = -1;
+    
+    size_t semi = text.find(';');
+    std::string_view endpoint = text.substr(0, semi);
     
-    for (const auto& pair : param_pairs) {
+    std::string_view host;
+    std::string_view port_str;
+    bool bracketed;
+    if (!split_host_port(endpoint, host, port_str, bracketed)) {
+      return false;
+    }
+    if (host.empty()) {
+      metrics_note_reject(REJECT_EMPTY);
+      return false;
+    }
+    if (!classify_into(host, bracketed, member)) {
+      return false;
+    }
+    member.host = host;
+    
+    if (parse_int(port_str, member.port, 1, 65535) != PARSE_INT_OK) {
+      metrics_note_reject(REJECT_OUT_OF_RANGE);
+      return false;
+    }
+    
+    while (semi != std::string_view::npos) {
+      size_t next = text.find(';', semi + 1);
+      std::string_view attr = text.substr(semi + 1, next == std::string_view::npos
+                                                        ? std::string_view::npos
+                                                        : next - semi - 1);
+      semi = next;
+      
+      std::string_view key, value;
+      if (!parse_key_value_pair(attr, key, value)) {
+        metrics_note_reject(REJECT_BAD_FORMAT);
+        return false;
+      }
+      int* field = nullptr;
+      if (key == "weight") {
+        field = &member.weight;
+      } else if (key == "priority") {
+        field = &member.priority;
+      } else {
+        metrics_note_reject(REJECT_BAD_FORMAT);
+        return false;
+      }
+      if (parse_int(value, *field, 0, 65535) != PARSE_INT_OK) {
+        metrics_note_reject(REJECT_OUT_OF_RANGE);
+        return false;
+      }
+    }
+    return true;
+  }
+  
+  // 解析参数部分，按'&'逐段处理，不构造中间容器
+  template <typename Options>
+  bool parse_parameters(std::string_view param_part, Options& opt) {
+    return parse_parameters(param_part, opt,
+                            [](std::string_view, std::string_view) { return false; });
+  }
+  
+  // extra(key, value)先于通用参数处理，返回true表示该参数已被处理
+  template <typename Options, typename ExtraFn>
+  bool parse_parameters(std::string_view param_part, Options& opt, ExtraFn extra) {
+    size_t start = 0;
+    while (start < param_part.size()) {
+      size_t amp = param_part.find('&', start);
+      if (amp == std::string_view::npos) amp = param_part.size();
+      std::string_view pair = param_part.substr(start, amp - start);
+      start = amp + 1;
+      
       if (pair.empty()) continue;
       
-      std::string key, value;
+      std::string_view key, value;
       if (!parse_key_value_pair(pair, key, value)) {
         continue;  // 跳过无效的参数对
       }
       
       // 根据key设置对应的选项值
-      apply_parameter(key, value, opt);
+      if (!extra(key, value)) {
+        apply_parameter(key, value, opt);
+      }
     }
     
     return true;
   }
   
   // 解析键值对
-  bool parse_key_value_pair(const std::string& pair, std::string& key, std::string& value) {
+  bool parse_key_value_pair(std::string_view pair, std::string_view& key,
+                            std::string_view& value) {
     size_t equal_pos = pair.find('=');
-    if (equal_pos == std::string::npos) {
+    if (equal_pos == std::string_view::npos) {
       // 没有=号，整个作为key，value为空
       key = trim_string(pair);
-      value = "";
+      value = std::string_view();
     } else {
       key = trim_string(pair.substr(0, equal_pos));
       value = trim_string(pair.substr(equal_pos + 1));
@@ -169,7 +396,8 @@ private:
   }
   
   // 应用参数到选项结构体
-  void apply_parameter(const std::string& key, const std::string& value, srt_options& opt) {
+  template <typename Options>
+  void apply_parameter(std::string_view key, std::string_view value, Options& opt) {
     if (key == "mode") {
       if (!value.empty()) {
         opt.mode = value;
@@ -179,28 +407,30 @@ private:
     } else if (key == "passphrase") {
       opt.passphrase = value;  // 允许空值
     } else if (key == "pbkeylen") {
-      opt.pbkeylen = string_to_int(value, -1);
+      opt.pbkeylen = int_param(value);
     } else if (key == "latency") {
-      opt.latency = string_to_int(value, -1);
+      opt.latency = int_param(value);
     } else if (key == "maxbw") {
-      opt.maxbw = string_to_int(value, -1);
+      opt.maxbw = int_param(value);
     } else if (key == "rcvbuf") {
-      opt.rcvbuf = string_to_int(value, -1);
+      opt.rcvbuf = int_param(value);
     } else if (key == "sndbuf") {
-      opt.sndbuf = string_to_int(value, -1);
+      opt.sndbuf = int_param(value);
     } else if (key == "ipttl") {
-      opt.ipttl = string_to_int(value, -1);
+      opt.ipttl = int_param(value);
     } else if (key == "conntimeo") {
-      opt.conntimeo = string_to_int(value, -1);
+      opt.conntimeo = int_param(value);
     }
     // 忽略未知参数
   }
   
   // 后处理验证和调整
-  int post_process_validation(srt_options& opt) {
+  template <typename Options>
+  int post_process_validation(Options& opt) {
     // 如果是listener模式，清空host
     if (opt.mode == "listener") {
-      opt.host = "";
+      opt.host.clear();
+      clear_host(opt);
     }
     
     // 验证pbkeylen值
@@ -221,50 +451,288 @@ private:
     return 0;  // 成功
   }
   
-  // 辅助函数：字符串分割
-  std::vector<std::string> split_string(const std::string& str, char delimiter) {
-    std::vector<std::string> result;
-    std::stringstream ss(str);
-    std::string item;
+  // 辅助函数：整数参数
+  // 整个值必须是int范围内的十进制数（如 "120ms"、"1e3" 都无效），无效时返回-1（使用默认值）
+  static int int_param(std::string_view value) {
+    int v = -1;
+    return parse_int(value, v) == PARSE_INT_OK ? v : -1;
+  }
+  
+  // 辅助函数：去除字符串首尾空格
+  std::string_view trim_string(std::string_view str) {
+    size_t start = str.find_first_not_of(" \t\r\n");
+    if (start == std::string_view::npos) {
+      return std::string_view();
+    }
+    
+    size_t end = str.find_last_not_of(" \t\r\n");
+    return str.substr(start, end - start + 1);
+  }
+};
+
+// ===========================================
+// 参考实现：SRT URL解析器
+// 按当前规则独立实现（std::string切分、std::stoi转整数），不共享SrtUrlParserHelper的代码，
+// 作为影子校验的基准。规则与快速路径相同：URL长度上限、[v6]:port、端口和整数参数
+// 必须整串是十进制数（"120ms"、"9000abc"无效）；主机用is_valid_host_reference校验，
+// 类型和地址按inet_pton确定。修改解析规则时两边要同时修改
+// ===========================================
+class ReferenceSrtUrlParser {
+public:
+  int parse(const std::string& srt_url, srt_options& opt) {
+    init_default_options(opt);
+    
+    const std::string srt_prefix = "srt://";
+    if (srt_url.empty() || srt_url.length() > SRT_URL_MAX_LENGTH ||
+        srt_url.compare(0, srt_prefix.length(), srt_prefix) != 0 ||
+        srt_url.length() <= srt_prefix.length()) {
+      return -1;
+    }
+    
+    std::string url_body = srt_url.substr(srt_prefix.length());
+    std::string main_part = url_body;
+    std::string param_part;
+    size_t question_pos = url_body.find('?');
+    if (question_pos != std::string::npos) {
+      main_part = url_body.substr(0, question_pos);
+      param_part = url_body.substr(question_pos + 1);
+    }
     
-    while (std::getline(ss, item, delimiter)) {
-      result.push_back(item);
+    if (!parse_main_part(main_part, opt)) {
+      return -1;
     }
+    parse_parameters(param_part, opt);
     
-    return result;
+    if (opt.mode == "listener") {
+      opt.host = "";
+      clear_host(opt);
+    }
+    if (opt.pbkeylen != -1 && opt.pbkeylen != 16 && opt.pbkeylen != 24 && opt.pbkeylen != 32) {
+      opt.pbkeylen = -1;
+    }
+    return 0;
+  }
+
+private:
+  void init_default_options(srt_options& opt) {
+    opt.mode = "caller";
+    opt.host = "";
+    opt.port = -1;
+    clear_host(opt);
+    opt.streamid = "";
+    opt.passphrase = "";
+    opt.pbkeylen = -1;
+    opt.latency = -1;
+    opt.maxbw = -1;
+    opt.rcvbuf = -1;
+    opt.sndbuf = -1;
+    opt.ipttl = -1;
+    opt.conntimeo = -1;
   }
   
-  // 辅助函数：字符串转整数
-  int string_to_int(const std::string& str, int default_value) {
-    if (str.empty()) {
-      return default_value;
+  static void clear_host(srt_options& opt) {
+    opt.host_type = HOST_INVALID;
+    std::fill(opt.host_addr, opt.host_addr + sizeof(opt.host_addr), 0);
+  }
+  
+  // host:port或[v6]:port；主机无效时保持默认值返回false
+  bool parse_main_part(const std::string& main_part, srt_options& opt) {
+    if (main_part.empty()) {
+      return true;
     }
     
+    std::string host;
+    std::string port_str;
+    bool bracketed = main_part[0] == '[';
+    if (bracketed) {
+      size_t close_pos = main_part.find(']');
+      if (close_pos == std::string::npos || close_pos == 1) {
+        return false;
+      }
+      host = main_part.substr(1, close_pos - 1);
+      std::string rest = main_part.substr(close_pos + 1);
+      if (!rest.empty()) {
+        if (rest[0] != ':') {
+          return false;
+        }
+        port_str = rest.substr(1);
+      }
+    } else {
+      size_t colon_pos = main_part.find(':');
+      host = main_part.substr(0, colon_pos);
+      if (colon_pos != std::string::npos) {
+        port_str = main_part.substr(colon_pos + 1);
+      }
+    }
+    
+    if (!host.empty()) {
+      if (!is_valid_host_reference(host)) {
+        return false;
+      }
+      if (!bracketed && inet_pton(AF_INET, host.c_str(), opt.host_addr) == 1) {
+        opt.host_type = HOST_IPV4;
+      } else if (inet_pton(AF_INET6, host.c_str(), opt.host_addr) == 1) {
+        opt.host_type = HOST_IPV6;
+      } else if (!bracketed && host.find(':') == std::string::npos) {
+        opt.host_type = HOST_DOMAIN;
+      } else {
+        // 方括号内只允许可转换的IPv6
+        clear_host(opt);
+        return false;
+      }
+    }
+    opt.host = host;
+    
+    int port = string_to_int(port_str, -1);
+    opt.port = (port >= 1 && port <= 65535) ? port : -1;
+    return true;
+  }
+  
+  void parse_parameters(const std::string& param_part, srt_options& opt) {
+    std::stringstream ss(param_part);
+    std::string pair;
+    while (std::getline(ss, pair, '&')) {
+      if (pair.empty()) continue;
+      
+      std::string key, value;
+      size_t equal_pos = pair.find('=');
+      if (equal_pos == std::string::npos) {
+        key = trim_string(pair);
+      } else {
+        key = trim_string(pair.substr(0, equal_pos));
+        value = trim_string(pair.substr(equal_pos + 1));
+      }
+      if (key.empty()) continue;
+      
+      if (key == "mode") {
+        if (!value.empty()) {
+          opt.mode = value;
+        }
+      } else if (key == "streamid") {
+        opt.streamid = value;
+      } else if (key == "passphrase") {
+        opt.passphrase = value;
+      } else if (key == "pbkeylen") {
+        opt.pbkeylen = string_to_int(value, -1);
+      } else if (key == "latency") {
+        opt.latency = string_to_int(value, -1);
+      } else if (key == "maxbw") {
+        opt.maxbw = string_to_int(value, -1);
+      } else if (key == "rcvbuf") {
+        opt.rcvbuf = string_to_int(value, -1);
+      } else if (key == "sndbuf") {
+        opt.sndbuf = string_to_int(value, -1);
+      } else if (key == "ipttl") {
+        opt.ipttl = string_to_int(value, -1);
+      } else if (key == "conntimeo") {
+        opt.conntimeo = string_to_int(value, -1);
+      }
+    }
+  }
+  
+  // 整串必须是十进制数（可带一个前导'-'）；std::stoi本身会跳过前导空白和'+'，
+  // 并接受"120ms"这样的前缀，因此先检查首字符，再要求全部字符都被消耗
+  static int string_to_int(const std::string& str, int default_value) {
+    size_t digits = (!str.empty() && str[0] == '-') ? 1 : 0;
+    if (digits >= str.size() || !isdigit(static_cast<unsigned char>(str[digits]))) {
+      return default_value;
+    }
     try {
-      return std::stoi(str);
-    } catch (const std::exception& e) {
+      size_t pos = 0;
+      int value = std::stoi(str, &pos);
+      return pos == str.size() ? value : default_value;
+    } catch (const std::exception&) {
       return default_value;
     }
   }
   
-  // 辅助函数：去除字符串首尾空格
-  std::string trim_string(const std::string& str) {
+  static std::string trim_string(const std::string& str) {
     size_t start = str.find_first_not_of(" \t\r\n");
     if (start == std::string::npos) {
       return "";
     }
-    
     size_t end = str.find_last_not_of(" \t\r\n");
     return str.substr(start, end - start + 1);
   }
 };
 
+// ===========================================
+// 影子校验辅助函数
+// ===========================================
+// 把解析结果序列化为可比较的字符串
+static std::string shadow_result(int rc, const srt_options& opt) {
+  char nums[128];
+  snprintf(nums, sizeof(nums), "%d|%d|%d|%d|%d|%d|%d|%d|%d|%d|", rc, opt.port, opt.pbkeylen,
+           opt.latency, opt.maxbw, opt.rcvbuf, opt.sndbuf, opt.ipttl, opt.conntimeo,
+           static_cast<int>(opt.host_type));
+  std::string result(nums);
+  result.append(reinterpret_cast<const char*>(opt.host_addr), sizeof(opt.host_addr));
+  // 字符串字段带长度前缀，避免分隔符歧义
+  for (const std::string* field : {&opt.mode, &opt.host, &opt.streamid, &opt.passphrase}) {
+    result += std::to_string(field->size());
+    result += ':';
+    result += *field;
+  }
+  return result;
+}
+
+static std::string shadow_reference_srt(const std::string& srt_url) {
+  srt_options opt;
+  int rc = parse_srt_url_reference(srt_url, opt);
+  return shadow_result(rc, opt);
+}
+
 // ===========================================
 // 主函数实现
 // ===========================================
 int parse_srt_url(const std::string& srt_url, srt_options& opt) {
+  MetricTimer timer(METRIC_PARSE_SRT_URL);
   SrtUrlParserHelper parser;
-  return parser.parse(srt_url, opt);
+  int rc = parser.parse(srt_url, opt);
+  timer.finish(rc == 0);
+  if (shadow_should_sample()) {
+    shadow_submit(SHADOW_PARSE_SRT_URL, srt_url, shadow_result(rc, opt), shadow_reference_srt);
+  }
+  return rc;
+}
+
+int parse_srt_url_reference(const std::string& srt_url, srt_options& opt) {
+  return ReferenceSrtUrlParser().parse(srt_url, opt);
+}
+
+int parse_srt_url(std::string_view srt_url, pmr_srt_options& opt) {
+  MetricTimer timer(METRIC_PARSE_SRT_URL);
+  SrtUrlParserHelper parser;
+  int rc = parser.parse(srt_url, opt);
+  timer.finish(rc == 0);
+  return rc;
+}
+
+int parse_srt_group_url(std::string_view srt_url, srt_group_options& group) {
+  MetricTimer timer(METRIC_PARSE_SRT_GROUP_URL);
+  SrtUrlParserHelper parser;
+  int rc = parser.parse_group(srt_url, group);
+  timer.finish(rc == 0);
+  return rc;
+}
+
+srt_options to_srt_options(const pmr_srt_options& opt) {
+  srt_options out;
+  out.mode.assign(opt.mode.data(), opt.mode.size());
+  out.host.assign(opt.host.data(), opt.host.size());
+  out.port = opt.port;
+  out.host_type = opt.host_type;
+  std::copy(opt.host_addr, opt.host_addr + sizeof(opt.host_addr), out.host_addr);
+  out.streamid.assign(opt.streamid.data(), opt.streamid.size());
+  out.passphrase.assign(opt.passphrase.data(), opt.passphrase.size());
+  out.pbkeylen = opt.pbkeylen;
+  out.latency = opt.latency;
+  out.maxbw = opt.maxbw;
+  out.rcvbuf = opt.rcvbuf;
+  out.sndbuf = opt.sndbuf;
+  out.ipttl = opt.ipttl;
+  out.conntimeo = opt.conntimeo;
+  return out;
 }
 
 // 辅助函数：打印选项结构体
@@ -272,6 +740,8 @@ void print_srt_options(const srt_options& opt) {
   printf("  mode: \"%s\"\n", opt.mode.c_str());
   printf("  host: \"%s\"\n", opt.host.c_str());
   printf("  port: %d\n", opt.port);
+  static const char* const kinds[] = {"none", "ipv4", "ipv6", "domain"};
+  printf("  host_type: %s\n", kinds[opt.host_type]);
   printf("  streamid: \"%s\"\n", opt.streamid.c_str());
   printf("  passphrase: \"%s\"\n", opt.passphrase.c_str());
   printf("  pbkeylen: %d\n", opt.pbkeylen);
@@ -2,14 +2,21 @@
 #define SRT_URL_PARSER_H_
 
 #include <string>
+#include <algorithm>
+#include <string_view>
+#include <memory_resource>
 #include <map>
 #include <vector>
+#include "host_validator.h"
+#include "small_vector.h"
 
 // SRT选项结构体
 struct srt_options {
   std::string mode;                   // caller/listener，没有找到，则默认caller
-  std::string host;                   // 主机地址 (IP或域名)，listener模式为空
+  std::string host;                   // 主机地址 (IP或域名)，listener模式为空；IPv6不含方括号
   int port;                           // 端口号， -1表示使用默认值
+  host_kind host_type;                // 主机类型，host为空时为HOST_INVALID
+  unsigned char host_addr[16];        // IPv4(前4字节)/IPv6的网络字节序地址，域名时全0
   std::string streamid;               // 流标识符，空字符串表示忽略
   
   // === 安全参数 ===
@@ -27,8 +34,112 @@ struct srt_options {
   int conntimeo;                      // 连接超时(毫秒)，-1表示使用默认值
 };
 
+// 使用std::pmr分配器的SRT选项结构体，字段含义同srt_options
+// 整批重载时可以让所有字符串从同一个monotonic_buffer_resource分配，最后O(1)整体释放
+struct pmr_srt_options {
+  typedef std::pmr::polymorphic_allocator<char> allocator_type;
+
+  std::pmr::string mode;
+  std::pmr::string host;
+  int port;
+  host_kind host_type;
+  unsigned char host_addr[16];
+  std::pmr::string streamid;
+  std::pmr::string passphrase;
+  int pbkeylen;
+  int latency;
+  int maxbw;
+  int rcvbuf;
+  int sndbuf;
+  int ipttl;
+  int conntimeo;
+
+  explicit pmr_srt_options(allocator_type alloc = {})
+      : mode(alloc), host(alloc), port(-1), host_type(HOST_INVALID), host_addr(),
+        streamid(alloc), passphrase(alloc), pbkeylen(-1), latency(-1), maxbw(-1),
+        rcvbuf(-1), sndbuf(-1), ipttl(-1), conntimeo(-1) {}
+
+  // 支持uses-allocator构造，放入std::pmr::vector时字符串使用容器的内存资源
+  pmr_srt_options(const pmr_srt_options& other, allocator_type alloc)
+      : mode(other.mode, alloc), host(other.host, alloc), port(other.port),
+        host_type(other.host_type), host_addr(),
+        streamid(other.streamid, alloc), passphrase(other.passphrase, alloc),
+        pbkeylen(other.pbkeylen), latency(other.latency), maxbw(other.maxbw),
+        rcvbuf(other.rcvbuf), sndbuf(other.sndbuf), ipttl(other.ipttl),
+        conntimeo(other.conntimeo) {
+    std::copy(other.host_addr, other.host_addr + 16, host_addr);
+  }
+  pmr_srt_options(pmr_srt_options&& other, allocator_type alloc)
+      : mode(std::move(other.mode), alloc), host(std::move(other.host), alloc), port(other.port),
+        host_type(other.host_type), host_addr(),
+        streamid(std::move(other.streamid), alloc), passphrase(std::move(other.passphrase), alloc),
+        pbkeylen(other.pbkeylen), latency(other.latency), maxbw(other.maxbw),
+        rcvbuf(other.rcvbuf), sndbuf(other.sndbuf), ipttl(other.ipttl),
+        conntimeo(other.conntimeo) {
+    std::copy(other.host_addr, other.host_addr + 16, host_addr);
+  }
+  pmr_srt_options(const pmr_srt_options&) = default;
+  pmr_srt_options(pmr_srt_options&&) = default;
+  pmr_srt_options& operator=(const pmr_srt_options&) = default;
+  pmr_srt_options& operator=(pmr_srt_options&&) = default;
+
+  allocator_type get_allocator() const { return mode.get_allocator(); }
+};
+
+// URL总长度上限，超过时parse_srt_url/parse_srt_group_url直接返回-1
+const size_t SRT_URL_MAX_LENGTH = 4096;
+
 // 主函数声明
 int parse_srt_url(const std::string& srt_url, srt_options& opt);
 void print_srt_options(const srt_options& opt);
 
+// pmr版本：解析规则与parse_srt_url相同，所有字符串从opt的分配器分配
+int parse_srt_url(std::string_view srt_url, pmr_srt_options& opt);
+
+// pmr版本转换为普通版本
+srt_options to_srt_options(const pmr_srt_options& opt);
+
+// ===========================================
+// 连接组（bonding）多端点URL
+// srt://host1:port1;weight=10;priority=1,[v6]:port2,host3:port3?grouptype=backup&latency=200
+// 成员之间用','分隔，成员后可以用';'附加weight/priority，'?'后为整组共用的参数
+// ===========================================
+
+// 组类型
+enum srt_group_type {
+  SRT_GROUP_BROADCAST = 0,            // 广播：所有链路同时发送（未指定grouptype时的默认值）
+  SRT_GROUP_BACKUP,                   // 主备：按priority选择活动链路
+  SRT_GROUP_BALANCING,                // 负载均衡：按weight分配
+};
+
+// 组成员
+// host指向传入parse_srt_group_url的URL字符串，URL必须比成员列表存活更久
+struct srt_group_member {
+  std::string_view host;              // 主机地址，IPv6不含方括号
+  int port;                           // 端口号，成员必须带有效端口
+  host_kind host_type;                // 主机类型
+  unsigned char host_addr[16];        // 网络字节序地址，域名时全0
+  int weight;                         // 权重0-65535，-1表示使用默认值
+  int priority;                       // 优先级0-65535（数值越小越优先），-1表示使用默认值
+};
+
+// 常见的2-4个成员存放在内联存储中，解析不分配内存
+typedef small_vector<srt_group_member, 4> srt_group_member_list;
+
+// 连接组选项
+struct srt_group_options {
+  srt_group_type type;
+  srt_group_member_list members;
+  srt_options common;                 // 整组共用参数；host/port不使用，保持为空
+};
+
+// 解析连接组URL，成员在同一次解析中完成主机、端口和属性校验
+// 任一成员无效、grouptype未知或mode不是caller时返回-1
+// 不含','的普通URL按单成员组解析
+int parse_srt_group_url(std::string_view srt_url, srt_group_options& group);
+
+// 参考实现：按与parse_srt_url相同的规则独立实现，不经过快速路径、统计和影子校验，
+// 供shadow_verify在后台比对；主机用is_valid_host_reference校验
+int parse_srt_url_reference(const std::string& srt_url, srt_options& opt);
+
 #endif  // SRT_URL_PARSER_H_
@@ -0,0 +1,195 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory_resource>
+
+#include "srt_url_parser.h"
+#include "srt_streamid.h"
+#include "input_validation.h"
+#include "fix_domain_name.h"
+
+using namespace std;
+
+static int g_passed = 0;
+static int g_total = 0;
+
+static void check(const string& name, bool ok) {
+    g_total++;
+    cout << "测试: " << name << " ";
+    if (ok) {
+        cout << "✓ 通过" << endl;
+        g_passed++;
+    } else {
+        cout << "✗ 失败" << endl;
+    }
+}
+
+void testParse() {
+    cout << "=== parse_srt_url 测试 ===" << endl;
+    srt_options opt;
+
+    int rc = parse_srt_url("srt://example.com:9000?latency=200&streamid=cam1&pbkeylen=16", opt);
+    check("基本解析", rc == 0 && opt.mode == "caller" && opt.host == "example.com" &&
+                      opt.port == 9000 && opt.latency == 200 && opt.streamid == "cam1" &&
+                      opt.pbkeylen == 16);
+
+    rc = parse_srt_url("srt://:9000?mode=listener", opt);
+    check("listener模式", rc == 0 && opt.mode == "listener" && opt.host.empty() && opt.port == 9000);
+
+    rc = parse_srt_url("srt://h:70000?pbkeylen=20", opt);
+    check("无效端口和密钥长度", rc == 0 && opt.port == -1 && opt.pbkeylen == -1);
+
+    rc = parse_srt_url("srt://[2001:db8::1]:9000?latency=120", opt);
+    check("IPv6方括号", rc == 0 && opt.host == "2001:db8::1" && opt.port == 9000 &&
+                        opt.host_type == HOST_IPV6 && opt.host_addr[0] == 0x20 &&
+                        opt.host_addr[1] == 0x01 && opt.host_addr[15] == 1 && opt.latency == 120);
+
+    rc = parse_srt_url("srt://[::1]", opt);
+    check("IPv6无端口", rc == 0 && opt.host == "::1" && opt.port == -1 && opt.host_addr[15] == 1);
+
+    rc = parse_srt_url("srt://192.168.1.10:9000", opt);
+    check("IPv4二进制地址", rc == 0 && opt.host_type == HOST_IPV4 && opt.host_addr[0] == 192 &&
+                            opt.host_addr[3] == 10);
+
+    rc = parse_srt_url("srt://cam.example.com:9000", opt);
+    check("域名类型", rc == 0 && opt.host_type == HOST_DOMAIN);
+
+    check("主机含危险字符", parse_srt_url("srt://a;rm -rf:9000", opt) == -1);
+    check("IPv4段越界", parse_srt_url("srt://1.2.3.256:9000", opt) == -1);
+    check("方括号内不是IPv6", parse_srt_url("srt://[1.2.3.4]:9000", opt) == -1);
+    check("方括号未闭合", parse_srt_url("srt://[2001:db8::1:9000", opt) == -1);
+    check("方括号后缺少冒号", parse_srt_url("srt://[::1]9000", opt) == -1);
+    check("非标准IPv6写法", parse_srt_url("srt://[:::]:9000", opt) == -1);
+
+    rc = parse_srt_url("srt://0.0.0.0:9000?mode=listener", opt);
+    check("listener清空主机类型", rc == 0 && opt.host.empty() && opt.host_type == HOST_INVALID);
+
+    check("非srt协议", parse_srt_url("udp://1.2.3.4:9000", opt) == -1);
+    check("空URL", parse_srt_url("", opt) == -1);
+    check("只有协议头", parse_srt_url("srt://", opt) == -1);
+
+    rc = parse_srt_url("srt://h:9000?latency=120ms&maxbw=1e6&rcvbuf=99999999999&sndbuf=-1&ipttl=64", opt);
+    check("整数参数必须完整且不溢出", rc == 0 && opt.latency == -1 && opt.maxbw == -1 &&
+                                      opt.rcvbuf == -1 && opt.sndbuf == -1 && opt.ipttl == 64);
+    rc = parse_srt_url("srt://h:9000x", opt);
+    check("端口含尾部字符", rc == 0 && opt.port == -1);
+}
+
+void testPmr() {
+    cout << "\n=== pmr 版本测试 ===" << endl;
+
+    // 整批从一个缓冲区分配，最后一次性释放
+    char buffer[16384];
+    pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), pmr::null_memory_resource());
+
+    pmr::vector<pmr_srt_options> lineup(&arena);
+    vector<string> urls = {
+        "srt://a-very-long-host-name-that-defeats-sso.example.com:9000?streamid=live/cam1/main",
+        "srt://:9001?mode=listener&passphrase=0123456789abcdef",
+        "srt://10.0.0.1:9002?latency=120",
+    };
+    bool all_ok = true;
+    for (const string& url : urls) {
+        lineup.emplace_back();
+        all_ok = all_ok && parse_srt_url(string_view(url), lineup.back()) == 0;
+    }
+    check("pmr解析", all_ok && lineup[0].streamid == "live/cam1/main" &&
+                     lineup[1].mode == "listener" && lineup[2].latency == 120);
+    check("字符串使用容器的内存资源", lineup[0].host.get_allocator().resource() == &arena);
+
+    srt_options plain;
+    parse_srt_url(urls[0], plain);
+    srt_options converted = to_srt_options(lineup[0]);
+    check("与普通版本一致", converted.host == plain.host && converted.port == plain.port &&
+                            converted.streamid == plain.streamid);
+
+    pmr::string quoted = shell_quote("it's", &arena);
+    check("pmr shell_quote", quoted == "'it'\\''s'" && string(quoted.c_str()) == shell_quote("it's"));
+
+    pmr::string fixed = fix_domain_name("--My_Host--Name!!", &arena);
+    check("pmr fix_domain_name", fixed == "MyHost-Name" && fix_domain_name(string("--My_Host--Name!!")) == "MyHost-Name");
+}
+
+void testGroup() {
+    cout << "\n=== 连接组URL测试 ===" << endl;
+    srt_group_options group;
+
+    string url = "srt://10.0.0.1:9000;weight=10;priority=1,[2001:db8::2]:9001;priority=2,"
+                 "cam.example.com:9002?grouptype=backup&latency=200&streamid=cam1";
+    int rc = parse_srt_group_url(url, group);
+    check("三成员主备组", rc == 0 && group.type == SRT_GROUP_BACKUP && group.members.size() == 3 &&
+                          group.members.is_inline() && group.common.latency == 200 &&
+                          group.common.streamid == "cam1" && group.common.host.empty());
+    if (rc == 0 && group.members.size() == 3) {
+        const srt_group_member& a = group.members[0];
+        const srt_group_member& b = group.members[1];
+        const srt_group_member& c = group.members[2];
+        check("成员属性", a.host == "10.0.0.1" && a.port == 9000 && a.host_type == HOST_IPV4 &&
+                          a.host_addr[0] == 10 && a.weight == 10 && a.priority == 1);
+        check("IPv6成员", b.host == "2001:db8::2" && b.port == 9001 && b.host_type == HOST_IPV6 &&
+                          b.host_addr[15] == 2 && b.weight == -1 && b.priority == 2);
+        check("域名成员", c.host == "cam.example.com" && c.host_type == HOST_DOMAIN &&
+                          c.weight == -1 && c.priority == -1);
+    }
+
+    rc = parse_srt_group_url("srt://1.1.1.1:9000", group);
+    check("单成员默认广播", rc == 0 && group.type == SRT_GROUP_BROADCAST && group.members.size() == 1);
+
+    string many = "srt://";
+    for (int i = 1; i <= 6; i++) {
+        many += (i > 1 ? ",10.0.0." : "10.0.0.") + to_string(i) + ":900" + to_string(i);
+    }
+    rc = parse_srt_group_url(many + "?grouptype=balancing", group);
+    check("超过内联容量", rc == 0 && group.type == SRT_GROUP_BALANCING && group.members.size() == 6 &&
+                          !group.members.is_inline() && group.members[5].port == 9006);
+
+    check("成员缺少端口", parse_srt_group_url("srt://1.1.1.1:9000,2.2.2.2", group) == -1);
+    check("空成员", parse_srt_group_url("srt://1.1.1.1:9000,,2.2.2.2:9000", group) == -1);
+    check("成员主机无效", parse_srt_group_url("srt://1.1.1.1:9000,1.2.3.256:9000", group) == -1);
+    check("未知成员属性", parse_srt_group_url("srt://1.1.1.1:9000;cost=3", group) == -1);
+    check("权重越界", parse_srt_group_url("srt://1.1.1.1:9000;weight=70000", group) == -1);
+    check("权重非数字", parse_srt_group_url("srt://1.1.1.1:9000;weight=5x", group) == -1);
+    check("未知组类型", parse_srt_group_url("srt://1.1.1.1:9000?grouptype=mesh", group) == -1);
+    check("组不支持listener", parse_srt_group_url("srt://1.1.1.1:9000?mode=listener", group) == -1);
+    check("失败时清空成员", group.members.empty());
+}
+
+void testStreamid() {
+    cout << "\n=== streamid访问控制解析测试 ===" << endl;
+
+    srt_options opt;
+    int rc = parse_srt_url("srt://1.1.1.1:9000?streamid=#!::r=live/cam1,m=publish,u=alice,s=abc,room=7", opt);
+    srt_streamid sid;
+    bool ok = rc == 0 && parse_srt_streamid(opt, sid);
+    check("标准键", ok && sid.structured && sid.resource == "live/cam1" && sid.mode == "publish" &&
+                    sid.user == "alice" && sid.session == "abc" && sid.host.empty() && sid.type.empty());
+    check("自定义键", ok && sid.custom.size() == 1 && sid.custom[0].key == "room" &&
+                      sid.get("room") == "7" && sid.get("u") == "alice" && sid.get("x").empty());
+    check("不复制字符串", ok && sid.resource.data() >= opt.streamid.data() &&
+                          sid.resource.data() < opt.streamid.data() + opt.streamid.size());
+
+    check("普通streamid快速路径", parse_srt_streamid("live/cam1", sid) && !sid.structured &&
+                                  sid.resource == "live/cam1" && sid.custom.empty());
+    check("空streamid", parse_srt_streamid("", sid) && !sid.structured && sid.resource.empty());
+    check("允许空值", parse_srt_streamid("#!::r=,h=example.com", sid) && sid.resource.empty() &&
+                      sid.host == "example.com");
+    check("值中可含'='", parse_srt_streamid("#!::u=a=b", sid) && sid.user == "a=b");
+    check("缺少'='", !parse_srt_streamid("#!::r=a,publish", sid));
+    check("空键", !parse_srt_streamid("#!::=a", sid));
+    check("空项", !parse_srt_streamid("#!::r=a,,m=publish", sid));
+    check("只有前缀", !parse_srt_streamid("#!::", sid));
+    check("重复标准键", !parse_srt_streamid("#!::r=a,r=b", sid));
+    check("重复自定义键", !parse_srt_streamid("#!::x=1,x=2", sid));
+    check("多字符键不是标准键", parse_srt_streamid("#!::rr=1,t=file", sid) && sid.resource.empty() &&
+                                sid.get("rr") == "1" && sid.type == "file");
+}
+
+int main() {
+    testParse();
+    testPmr();
+    testGroup();
+    testStreamid();
+
+    cout << "\n测试结果: " << g_passed << "/" << g_total << " 通过" << endl;
+    return g_passed == g_total ? 0 : 1;
+}
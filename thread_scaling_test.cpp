@@ -0,0 +1,195 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <cstdlib>
+
+#include "host_validator.h"
+#include "input_validation.h"
+#include "srt_url_parser.h"
+#include "validation_metrics.h"
+
+using namespace std;
+
+// 多线程压力测试：每个公开校验函数分别用1,2,4,...,N个线程跑固定时长，
+// 输出每线程和总体的ops/sec，并检查并发下每次调用的结果与单线程一致。
+// 用法：thread_scaling_test [最大线程数] [每档毫秒数] [最低扩展效率]
+// 最低扩展效率默认为0（不检查），在专用多核机器上可设为如0.8
+
+static int g_passed = 0;
+static int g_total = 0;
+
+static void check(const string& name, bool ok) {
+    g_total++;
+    cout << "测试: " << name << " ";
+    if (ok) {
+        cout << "✓ 通过" << endl;
+        g_passed++;
+    } else {
+        cout << "✗ 失败" << endl;
+    }
+}
+
+struct bench_target {
+    const char* name;
+    vector<string> inputs;
+    function<bool(const string&)> call;
+};
+
+// 每个线程的结果单独占一个缓存行，测试框架本身不引入伪共享
+struct alignas(64) thread_result {
+    uint64_t ops;
+    uint64_t passed;
+    bool consistent;
+};
+
+struct step_result {
+    unsigned threads;
+    double aggregate;       // 总ops/sec
+    double min_thread;      // 最慢线程ops/sec
+    double max_thread;      // 最快线程ops/sec
+    bool consistent;
+};
+
+// threads个线程同时对inputs循环调用，直到duration结束
+static step_result run_step(const bench_target& t, unsigned threads, chrono::milliseconds duration,
+                            const vector<char>& expected) {
+    vector<thread_result> results(threads);
+    atomic<bool> start(false);
+    atomic<bool> stop(false);
+    vector<thread> workers;
+    for (unsigned i = 0; i < threads; i++) {
+        workers.emplace_back([&, i]() {
+            thread_result r = {0, 0, true};
+            while (!start.load(memory_order_acquire)) {
+                this_thread::yield();
+            }
+            // 每轮跑完整个输入集再检查停止标志
+            while (!stop.load(memory_order_relaxed)) {
+                for (size_t k = 0; k < t.inputs.size(); k++) {
+                    bool ok = t.call(t.inputs[k]);
+                    if (ok != (expected[k] != 0)) r.consistent = false;
+                    r.passed += ok;
+                }
+                r.ops += t.inputs.size();
+            }
+            results[i] = r;
+        });
+    }
+    auto begin = chrono::steady_clock::now();
+    start.store(true, memory_order_release);
+    this_thread::sleep_for(duration);
+    stop.store(true, memory_order_relaxed);
+    for (thread& w : workers) {
+        w.join();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - begin).count();
+
+    step_result s = {threads, 0, 0, 0, true};
+    for (unsigned i = 0; i < threads; i++) {
+        double rate = results[i].ops / seconds;
+        s.aggregate += rate;
+        s.min_thread = (i == 0 || rate < s.min_thread) ? rate : s.min_thread;
+        s.max_thread = (i == 0 || rate > s.max_thread) ? rate : s.max_thread;
+        s.consistent = s.consistent && results[i].consistent;
+    }
+    return s;
+}
+
+static vector<bench_target> build_targets() {
+    vector<bench_target> targets;
+    targets.push_back({"is_valid_host",
+                       {"example.com", "www.sub.example.co.uk", "192.168.1.1", "2001:db8::1",
+                        "::ffff:10.0.0.1", "bad_host", "a;rm -rf", "1.2.3.256", string(300, 'a')},
+                       [](const string& s) { return is_valid_host(s); }});
+    targets.push_back({"validate_ipv4", {"192.168.1.1", "10.0.0.255", "256.1.1.1", "1.2.3", "a.b.c.d"},
+                       [](const string& s) { return validate_ipv4(s); }});
+    targets.push_back({"validate_ipv6", {"2001:db8::1", "::1", "fe80::1%eth0", "1:2:3:4:5:6:7:8:9", "::ffff:1.2.3.4"},
+                       [](const string& s) { return validate_ipv6(s); }});
+    targets.push_back({"validate_netmask", {"255.255.255.0", "255.255.0.255", "0.0.0.0", "255.255.255.255"},
+                       [](const string& s) { return validate_netmask(s); }});
+    targets.push_back({"validate_mac_address", {"00:11:22:33:44:55", "00-11-22-33-44-55", "0011.2233.4455", "00:11:22:33:44"},
+                       [](const string& s) { return validate_mac_address(s); }});
+    targets.push_back({"validate_interface_name", {"eth0", "eth0:1", "wlan_0", "0eth", "averyveryverylongname"},
+                       [](const string& s) { return validate_interface_name(s); }});
+    targets.push_back({"validate_hostname", {"example.com", "a-b.c-d.example", "-bad.com", "a..b", string(70, 'a')},
+                       [](const string& s) { return validate_hostname(s); }});
+    targets.push_back({"validate_port", {"80", "65535", "0", "65536"},
+                       [](const string& s) { return validate_port(atoi(s.c_str())); }});
+    targets.push_back({"validate_filepath", {"var/log/app.log", "../etc/passwd", "/abs/path", "a/b c", "a..b/c"},
+                       [](const string& s) { return validate_filepath(s); }});
+    targets.push_back({"validate_numeric", {"12345", "", "12a", string(100, '9')},
+                       [](const string& s) { return validate_numeric(s); }});
+    targets.push_back({"validate_numeric(range)", {"8080", "70000", "-1", "99999999999999999999"},
+                       [](const string& s) { return validate_numeric(s, 1, 65535); }});
+    targets.push_back({"validate_alphanumeric", {"abcXYZ123", "abc-123", "", "中文"},
+                       [](const string& s) { return validate_alphanumeric(s); }});
+    targets.push_back({"parse_srt_url",
+                       {"srt://192.168.1.1:9000?latency=200&streamid=live/cam1",
+                        "srt://[2001:db8::1]:9000?mode=caller&passphrase=0123456789abcdef&pbkeylen=16",
+                        "srt://:9000?mode=listener", "srt://example.com:9000?maxbw=1000000&rcvbuf=8192",
+                        "http://example.com", "srt://a;b:9000"},
+                       [](const string& s) { srt_options opt; return parse_srt_url(s, opt) == 0; }});
+    return targets;
+}
+
+int main(int argc, char* argv[]) {
+    cout << "=== 多线程扩展性测试 ===" << endl;
+
+    unsigned hw = thread::hardware_concurrency();
+    unsigned max_threads = argc > 1 ? static_cast<unsigned>(atoi(argv[1])) : (hw < 2 ? 2 : hw);
+    chrono::milliseconds step_ms(argc > 2 ? atoi(argv[2]) : 100);
+    double min_efficiency = argc > 3 ? atof(argv[3]) : 0.0;
+    if (max_threads == 0) max_threads = 1;
+    cout << "CPU核数: " << hw << "，最大线程数: " << max_threads << "，每档: " << step_ms.count() << "ms" << endl;
+
+    vector<unsigned> steps;
+    for (unsigned n = 1; n < max_threads; n *= 2) steps.push_back(n);
+    steps.push_back(max_threads);
+
+    vector<bench_target> targets = build_targets();
+    for (const bench_target& t : targets) {
+        vector<char> expected;
+        for (const string& s : t.inputs) expected.push_back(t.call(s) ? 1 : 0);
+
+        cout << endl << t.name << endl;
+        cout << setw(8) << "线程" << setw(16) << "总ops/s" << setw(16) << "最慢线程" << setw(16) << "最快线程"
+             << setw(10) << "效率" << endl;
+        bool consistent = true;
+        bool scaled = true;
+        double single = 0;
+        for (unsigned n : steps) {
+            step_result s = run_step(t, n, step_ms, expected);
+            if (n == 1) single = s.aggregate;
+            // 效率：总吞吐 / (线程数 × 单线程吞吐)，超过CPU核数的部分按核数计
+            unsigned usable = (hw != 0 && n > hw) ? hw : n;
+            double efficiency = single > 0 ? s.aggregate / (usable * single) : 0;
+            cout << fixed << setprecision(0) << setw(8) << n << setw(16) << s.aggregate << setw(16)
+                 << s.min_thread << setw(16) << s.max_thread << setprecision(2) << setw(10) << efficiency << endl;
+            consistent = consistent && s.consistent;
+            if (n > 1 && efficiency < min_efficiency) scaled = false;
+        }
+        check(string(t.name) + " 并发结果一致", consistent);
+        if (min_efficiency > 0) {
+            check(string(t.name) + " 扩展效率", scaled);
+        }
+    }
+
+    // 开启指标后多线程调用，按线程汇总的计数不丢失
+    metrics_reset();
+    metrics_enable(true);
+    step_result s = run_step(targets[0], max_threads, step_ms, vector<char>{1, 1, 1, 1, 1, 0, 0, 0, 0});
+    metrics_enable(false);
+    metrics_snapshot snap;
+    metrics_read(snap);
+    check("开启指标时并发结果一致", s.consistent);
+    check("指标计数完整", snap.funcs[METRIC_IS_VALID_HOST].calls > 0 &&
+                          snap.funcs[METRIC_IS_VALID_HOST].rejects * 9 == snap.funcs[METRIC_IS_VALID_HOST].calls * 4);
+
+    cout << endl << "测试结果: " << g_passed << "/" << g_total << " 通过" << endl;
+    return g_passed == g_total ? 0 : 1;
+}
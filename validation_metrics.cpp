@@ -0,0 +1,197 @@
+#include "validation_metrics.h"
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+metrics_enabled_flag g_metrics_enabled;
+thread_local reject_reason g_metrics_last_reject = REJECT_NONE;
+
+// 单个函数的线程内计数器，只有所属线程写入
+struct metric_counters {
+    std::atomic<uint64_t> calls;
+    std::atomic<uint64_t> rejects;
+    std::atomic<uint64_t> reasons[REJECT_REASON_COUNT];
+    std::atomic<uint64_t> latency[METRIC_LATENCY_BUCKETS];
+};
+
+// 每个线程一块，按缓存行对齐避免伪共享
+struct alignas(64) thread_metrics {
+    metric_counters funcs[METRIC_FUNC_COUNT];
+};
+
+// 全局登记表
+struct metrics_registry {
+    std::mutex mutex;
+    std::vector<thread_metrics*> threads;
+    metrics_snapshot retired;       // 已退出线程的累计值
+    metrics_snapshot baseline;      // metrics_reset时的基线
+};
+
+static metrics_registry& registry() {
+    // 有意泄漏，保证线程退出时（可能晚于静态析构）仍可访问
+    static metrics_registry* reg = new metrics_registry();
+    return *reg;
+}
+
+static void add_counters(metric_stats& dst, const metric_counters& src) {
+    dst.calls += src.calls.load(std::memory_order_relaxed);
+    dst.rejects += src.rejects.load(std::memory_order_relaxed);
+    for (size_t r = 0; r < REJECT_REASON_COUNT; r++) {
+        dst.reasons[r] += src.reasons[r].load(std::memory_order_relaxed);
+    }
+    for (size_t b = 0; b < METRIC_LATENCY_BUCKETS; b++) {
+        dst.latency[b] += src.latency[b].load(std::memory_order_relaxed);
+    }
+}
+
+// 线程槽：首次记录时分配并登记，线程退出时把计数并入retired
+struct thread_slot {
+    thread_metrics* metrics = nullptr;
+
+    thread_metrics* get() {
+        if (metrics == nullptr) {
+            metrics = new thread_metrics();
+            for (metric_counters& c : metrics->funcs) {
+                c.calls.store(0, std::memory_order_relaxed);
+                c.rejects.store(0, std::memory_order_relaxed);
+                for (auto& r : c.reasons) r.store(0, std::memory_order_relaxed);
+                for (auto& b : c.latency) b.store(0, std::memory_order_relaxed);
+            }
+            metrics_registry& reg = registry();
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            reg.threads.push_back(metrics);
+        }
+        return metrics;
+    }
+
+    ~thread_slot() {
+        if (metrics == nullptr) {
+            return;
+        }
+        metrics_registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (size_t f = 0; f < METRIC_FUNC_COUNT; f++) {
+            add_counters(reg.retired.funcs[f], metrics->funcs[f]);
+        }
+        reg.threads.erase(std::remove(reg.threads.begin(), reg.threads.end(), metrics),
+                          reg.threads.end());
+        delete metrics;
+    }
+};
+
+static thread_local thread_slot t_slot;
+
+// 单写者计数：读-加-写即可，不需要带锁前缀的原子加
+static inline void bump(std::atomic<uint64_t>& counter) {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+static inline size_t latency_bucket(uint64_t nanos) {
+    size_t b = nanos == 0 ? 0 : 64 - static_cast<size_t>(__builtin_clzll(nanos));
+    return b < METRIC_LATENCY_BUCKETS ? b : METRIC_LATENCY_BUCKETS - 1;
+}
+
+void metrics_record(metric_func func, reject_reason reason, uint64_t nanos) {
+    metric_counters& c = t_slot.get()->funcs[func];
+    bump(c.calls);
+    if (reason != REJECT_NONE) {
+        bump(c.rejects);
+        bump(c.reasons[reason]);
+    }
+    bump(c.latency[latency_bucket(nanos)]);
+}
+
+void metrics_enable(bool enable) {
+    g_metrics_enabled.value.store(enable, std::memory_order_relaxed);
+}
+
+// 汇总原始计数，调用方需持有reg.mutex
+static void collect_locked(metrics_registry& reg, metrics_snapshot& snap) {
+    snap = reg.retired;
+    for (thread_metrics* t : reg.threads) {
+        for (size_t f = 0; f < METRIC_FUNC_COUNT; f++) {
+            add_counters(snap.funcs[f], t->funcs[f]);
+        }
+    }
+}
+
+void metrics_read(metrics_snapshot& snap) {
+    metrics_registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    collect_locked(reg, snap);
+
+    for (size_t f = 0; f < METRIC_FUNC_COUNT; f++) {
+        metric_stats& s = snap.funcs[f];
+        const metric_stats& base = reg.baseline.funcs[f];
+        s.calls -= base.calls;
+        s.rejects -= base.rejects;
+        for (size_t r = 0; r < REJECT_REASON_COUNT; r++) s.reasons[r] -= base.reasons[r];
+        for (size_t b = 0; b < METRIC_LATENCY_BUCKETS; b++) s.latency[b] -= base.latency[b];
+    }
+}
+
+void metrics_reset() {
+    metrics_registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    collect_locked(reg, reg.baseline);
+}
+
+uint64_t metrics_latency_percentile(const metric_stats& stats, double p) {
+    uint64_t total = 0;
+    for (size_t b = 0; b < METRIC_LATENCY_BUCKETS; b++) total += stats.latency[b];
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t target = static_cast<uint64_t>(p * static_cast<double>(total));
+    if (target == 0) target = 1;
+    uint64_t seen = 0;
+    for (size_t b = 0; b < METRIC_LATENCY_BUCKETS; b++) {
+        seen += stats.latency[b];
+        if (seen >= target) {
+            return b == 0 ? 0 : (1ULL << b) - 1;
+        }
+    }
+    return (1ULL << (METRIC_LATENCY_BUCKETS - 1)) - 1;
+}
+
+const char* metric_func_name(metric_func func) {
+    static const char* const names[METRIC_FUNC_COUNT] = {
+        "is_valid_host", "parse_srt_url", "validate_ipv4", "validate_ipv6",
+        "validate_netmask", "validate_mac_address", "validate_interface_name",
+        "validate_hostname", "validate_port", "validate_filepath",
+        "validate_numeric", "validate_alphanumeric", "parse_srt_group_url",
+    };
+    return func < METRIC_FUNC_COUNT ? names[func] : "unknown";
+}
+
+const char* reject_reason_name(reject_reason reason) {
+    static const char* const names[REJECT_REASON_COUNT] = {
+        "none", "empty", "too_long", "dangerous_char", "bad_char",
+        "label_empty", "label_too_long", "label_hyphen", "octet_count",
+        "bad_octet", "leading_zero", "double_colon", "group_count",
+        "bad_hex_group", "bad_format", "out_of_range", "path_traversal",
+        "bad_scheme", "other",
+    };
+    return reason < REJECT_REASON_COUNT ? names[reason] : "unknown";
+}
+
+void print_metrics(const metrics_snapshot& snap) {
+    for (size_t f = 0; f < METRIC_FUNC_COUNT; f++) {
+        const metric_stats& s = snap.funcs[f];
+        if (s.calls == 0) continue;
+        printf("%s: calls=%llu rejects=%llu p50<=%lluns p99<=%lluns p999<=%lluns\n",
+               metric_func_name(static_cast<metric_func>(f)),
+               static_cast<unsigned long long>(s.calls),
+               static_cast<unsigned long long>(s.rejects),
+               static_cast<unsigned long long>(metrics_latency_percentile(s, 0.5)),
+               static_cast<unsigned long long>(metrics_latency_percentile(s, 0.99)),
+               static_cast<unsigned long long>(metrics_latency_percentile(s, 0.999)));
+        for (size_t r = 1; r < REJECT_REASON_COUNT; r++) {
+            if (s.reasons[r] == 0) continue;
+            printf("  %s: %llu\n", reject_reason_name(static_cast<reject_reason>(r)),
+                   static_cast<unsigned long long>(s.reasons[r]));
+        }
+    }
+}
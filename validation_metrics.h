@@ -0,0 +1,161 @@
+#ifndef VALIDATION_METRICS_H
+#define VALIDATION_METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// 校验函数运行指标（可选开启）
+// 记录每个校验函数的调用次数、拒绝原因分布和按2的幂分桶的耗时直方图。
+// 计数器按线程独立存放（单写者，无锁），读取时汇总。
+// 默认关闭，关闭时每次调用只多一次relaxed原子读和一个分支。
+
+// 被统计的函数
+enum metric_func {
+    METRIC_IS_VALID_HOST = 0,
+    METRIC_PARSE_SRT_URL,
+    METRIC_VALIDATE_IPV4,
+    METRIC_VALIDATE_IPV6,
+    METRIC_VALIDATE_NETMASK,
+    METRIC_VALIDATE_MAC_ADDRESS,
+    METRIC_VALIDATE_INTERFACE_NAME,
+    METRIC_VALIDATE_HOSTNAME,
+    METRIC_VALIDATE_PORT,
+    METRIC_VALIDATE_FILEPATH,
+    METRIC_VALIDATE_NUMERIC,
+    METRIC_VALIDATE_ALPHANUMERIC,
+    METRIC_PARSE_SRT_GROUP_URL,
+    METRIC_FUNC_COUNT
+};
+
+// 拒绝原因
+enum reject_reason {
+    REJECT_NONE = 0,            // 通过
+    REJECT_EMPTY,               // 空输入
+    REJECT_TOO_LONG,            // 总长度超限
+    REJECT_DANGEROUS_CHAR,      // 含危险字符 (;|&$等)
+    REJECT_BAD_CHAR,            // 含不允许的字符
+    REJECT_LABEL_EMPTY,         // 域名标签为空（连续的点、首尾的点）
+    REJECT_LABEL_TOO_LONG,      // 域名标签超过63字符
+    REJECT_LABEL_HYPHEN,        // 域名标签以连字符开头或结尾
+    REJECT_OCTET_COUNT,         // IPv4段数不是4
+    REJECT_BAD_OCTET,           // IPv4段为空、非数字或超过255
+    REJECT_LEADING_ZERO,        // IPv4段有前导零
+    REJECT_DOUBLE_COLON,        // IPv6出现多个"::"
+    REJECT_GROUP_COUNT,         // IPv6段数错误
+    REJECT_BAD_HEX_GROUP,       // IPv6段为空、超过4位或非十六进制
+    REJECT_BAD_FORMAT,          // 其他格式错误
+    REJECT_OUT_OF_RANGE,        // 数值超出范围
+    REJECT_PATH_TRAVERSAL,      // 路径含".."分量或为绝对路径
+    REJECT_BAD_SCHEME,          // URL不是srt://开头
+    REJECT_OTHER,               // 未标注原因的拒绝
+    REJECT_REASON_COUNT
+};
+
+// 耗时直方图桶数：第i桶统计[2^(i-1), 2^i)纳秒，最后一桶包含更大的值
+const size_t METRIC_LATENCY_BUCKETS = 32;
+
+// 单个函数的统计结果
+struct metric_stats {
+    uint64_t calls;
+    uint64_t rejects;
+    uint64_t reasons[REJECT_REASON_COUNT];
+    uint64_t latency[METRIC_LATENCY_BUCKETS];
+};
+
+// 全部函数的统计结果
+struct metrics_snapshot {
+    metric_stats funcs[METRIC_FUNC_COUNT];
+};
+
+// 开启/关闭统计
+void metrics_enable(bool enable);
+
+// 汇总所有线程（包括已退出线程）的计数
+void metrics_read(metrics_snapshot& snap);
+
+// 以当前计数为基线清零，之后metrics_read返回基线之后的增量
+void metrics_reset();
+
+// 按直方图估算耗时分位数（返回所在桶的上界，单位纳秒），p取值(0, 1]
+uint64_t metrics_latency_percentile(const metric_stats& stats, double p);
+
+const char* metric_func_name(metric_func func);
+const char* reject_reason_name(reject_reason reason);
+
+// 打印统计结果（跳过未被调用的函数）
+void print_metrics(const metrics_snapshot& snap);
+
+// ===========================================
+// 以下为埋点使用的内部接口
+// ===========================================
+// 每次校验都会读取的开关。alignas(64)的结构体大小向上取整为64字节，
+// 开关因此独占一个缓存行，其他全局变量的写入不会与它产生伪共享
+struct alignas(64) metrics_enabled_flag {
+    std::atomic<bool> value{false};
+};
+static_assert(sizeof(metrics_enabled_flag) == 64, "metrics_enabled_flag must fill one cache line");
+
+extern metrics_enabled_flag g_metrics_enabled;
+extern thread_local reject_reason g_metrics_last_reject;
+
+inline bool metrics_enabled() {
+    return g_metrics_enabled.value.load(std::memory_order_relaxed);
+}
+
+// 记录一次调用
+void metrics_record(metric_func func, reject_reason reason, uint64_t nanos);
+
+// 在多层校验的内部记录拒绝原因，由外层MetricTimer::finish取用
+inline void metrics_note_reject(reject_reason reason) {
+    if (metrics_enabled()) {
+        g_metrics_last_reject = reason;
+    }
+}
+
+// 函数入口处创建，返回前调用pass/reject/finish
+class MetricTimer {
+public:
+    explicit MetricTimer(metric_func func) : func_(func), active_(metrics_enabled()) {
+        if (active_) {
+            g_metrics_last_reject = REJECT_NONE;
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    bool pass() {
+        record(REJECT_NONE);
+        return true;
+    }
+
+    bool reject(reject_reason reason) {
+        record(reason);
+        return false;
+    }
+
+    // 根据结果记录，拒绝原因取内部通过metrics_note_reject记录的值
+    bool finish(bool ok) {
+        if (active_) {
+            reject_reason reason = g_metrics_last_reject;
+            record(ok ? REJECT_NONE : (reason == REJECT_NONE ? REJECT_OTHER : reason));
+        }
+        return ok;
+    }
+
+private:
+    void record(reject_reason reason) {
+        if (active_) {
+            auto elapsed = std::chrono::steady_clock::now() - start_;
+            metrics_record(func_, reason, static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+            active_ = false;
+        }
+    }
+
+    metric_func func_;
+    bool active_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+#endif // VALIDATION_METRICS_H
@@ -0,0 +1,99 @@
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "validation_metrics.h"
+#include "host_validator.h"
+#include "input_validation.h"
+#include "srt_url_parser.h"
+
+using namespace std;
+
+static int g_passed = 0;
+static int g_total = 0;
+
+static void check(const string& name, bool ok) {
+    g_total++;
+    cout << "测试: " << name << " ";
+    if (ok) {
+        cout << "✓ 通过" << endl;
+        g_passed++;
+    } else {
+        cout << "✗ 失败" << endl;
+    }
+}
+
+int main() {
+    cout << "=== validation_metrics 测试 ===" << endl;
+
+    metrics_snapshot snap;
+
+    // 关闭时不记录
+    is_valid_host("example.com");
+    metrics_read(snap);
+    check("关闭时不计数", snap.funcs[METRIC_IS_VALID_HOST].calls == 0);
+
+    metrics_enable(true);
+
+    is_valid_host("example.com");
+    is_valid_host("a;b.com");
+    is_valid_host(string(64, 'a') + ".com");
+    is_valid_host("1.2.3.256");
+    is_valid_host("192.168.01.1");
+    is_valid_host("1::2::3");
+    is_valid_host("-a.com");
+    is_valid_host("a..b");
+    validate_port(0);
+    validate_mac_address("AA:BB:CC:DD:EE:FF");
+    validate_filepath("../etc/passwd");
+
+    srt_options opt;
+    parse_srt_url("udp://1.2.3.4:9000", opt);
+    parse_srt_url("srt://1.2.3.4:9000", opt);
+    srt_group_options group;
+    parse_srt_group_url("srt://1.2.3.4:9000,5.6.7.8:9000", group);
+
+    // 其他线程的计数在读取时汇总，线程退出后仍保留
+    thread t([] {
+        for (int i = 0; i < 100; i++) validate_ipv4("10.0.0.1");
+        validate_ipv4("10.0.0");
+    });
+    t.join();
+
+    metrics_read(snap);
+    const metric_stats& host = snap.funcs[METRIC_IS_VALID_HOST];
+    check("is_valid_host 调用次数", host.calls == 8 && host.rejects == 7);
+    check("危险字符", host.reasons[REJECT_DANGEROUS_CHAR] == 1);
+    check("标签过长", host.reasons[REJECT_LABEL_TOO_LONG] == 1);
+    check("IPv4段错误", host.reasons[REJECT_BAD_OCTET] == 1);
+    check("IPv4前导零", host.reasons[REJECT_LEADING_ZERO] == 1);
+    check("多个双冒号", host.reasons[REJECT_DOUBLE_COLON] == 1);
+    check("标签连字符", host.reasons[REJECT_LABEL_HYPHEN] == 1);
+    check("空标签", host.reasons[REJECT_LABEL_EMPTY] == 1);
+    check("端口越界", snap.funcs[METRIC_VALIDATE_PORT].reasons[REJECT_OUT_OF_RANGE] == 1);
+    check("路径遍历", snap.funcs[METRIC_VALIDATE_FILEPATH].reasons[REJECT_PATH_TRAVERSAL] == 1);
+    check("SRT协议头", snap.funcs[METRIC_PARSE_SRT_URL].calls == 2 &&
+                       snap.funcs[METRIC_PARSE_SRT_URL].reasons[REJECT_BAD_SCHEME] == 1);
+    check("连接组URL单独计数", snap.funcs[METRIC_PARSE_SRT_GROUP_URL].calls == 1 &&
+                               snap.funcs[METRIC_PARSE_SRT_GROUP_URL].rejects == 0 &&
+                               string(metric_func_name(METRIC_PARSE_SRT_GROUP_URL)) == "parse_srt_group_url");
+    check("跨线程汇总", snap.funcs[METRIC_VALIDATE_IPV4].calls == 101 &&
+                        snap.funcs[METRIC_VALIDATE_IPV4].rejects == 1);
+
+    uint64_t latency_total = 0;
+    for (uint64_t b : host.latency) latency_total += b;
+    check("耗时直方图", latency_total == host.calls &&
+                        metrics_latency_percentile(host, 0.99) > 0);
+
+    print_metrics(snap);
+
+    metrics_reset();
+    is_valid_host("example.com");
+    metrics_read(snap);
+    check("重置基线", snap.funcs[METRIC_IS_VALID_HOST].calls == 1 &&
+                      snap.funcs[METRIC_VALIDATE_IPV4].calls == 0);
+
+    cout << "\n测试结果: " << g_passed << "/" << g_total << " 通过" << endl;
+    return g_passed == g_total ? 0 : 1;
+}
@@ -0,0 +1,384 @@
+#include "validation_pipeline.h"
+#include "host_validator.h"
+#include "input_validation.h"
+#include "srt_url_parser.h"
+#include "cidr.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cerrno>
+#include <poll.h>
+#include <unistd.h>
+
+bool check_srt_url_record(const std::string& url) {
+    srt_options opt;
+    return parse_srt_url(url, opt) == 0;
+}
+
+record_check_fn pipeline_check_by_name(std::string_view name) {
+    static const struct {
+        const char* name;
+        record_check_fn check;
+    } CHECKS[] = {
+        {"host", is_valid_host},
+        {"ipv4", validate_ipv4},
+        {"ipv6", validate_ipv6},
+        {"hostname", validate_hostname},
+        {"netmask", validate_netmask},
+        {"cidr", validate_cidr},
+        {"mac", validate_mac_address},
+        {"interface", validate_interface_name},
+        {"filepath", validate_filepath},
+        {"numeric", validate_numeric},
+        {"alphanumeric", validate_alphanumeric},
+        {"srt", check_srt_url_record},
+    };
+    for (const auto& c : CHECKS) {
+        if (name == c.name) {
+            return c.check;
+        }
+    }
+    return nullptr;
+}
+
+pipeline_options default_pipeline_options(record_check_fn check) {
+    pipeline_options o;
+    o.check = check;
+    o.workers = 0;
+    o.read_size = 1 << 20;
+    o.batch_records = 4096;
+    o.max_record = 64 * 1024;
+    o.max_delay_ms = 5;
+    o.max_inflight = 0;
+    return o;
+}
+
+// 批次中的一条记录
+struct pipe_record {
+    uint32_t offset;
+    uint32_t length;
+    bool truncated;                         // 超长被截断，直接判为0
+};
+
+// 一个批次：记录连续存放在data中
+struct pipe_batch {
+    std::string data;
+    std::vector<pipe_record> records;
+    std::vector<char> verdicts;
+    bool done;
+};
+
+typedef std::unique_ptr<pipe_batch> batch_ptr;
+
+// 读取线程、工作线程和输出线程共享的状态，全部由mutex保护
+struct pipeline_state {
+    std::mutex mutex;
+    std::condition_variable work_cv;        // 有新批次或已结束
+    std::condition_variable done_cv;        // 有批次完成或已结束
+    std::condition_variable space_cv;       // 在途批次减少
+    std::deque<pipe_batch*> work;           // 待校验
+    std::deque<batch_ptr> inflight;         // 已提交未输出，按提交顺序
+    std::vector<batch_ptr> free_list;       // 可复用的批次
+    bool closed = false;                    // 读取端已结束
+    bool write_failed = false;
+};
+
+static bool write_all(int fd, const char* p, size_t n) {
+    while (n > 0) {
+        ssize_t w = write(fd, p, n);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += w;
+        n -= static_cast<size_t>(w);
+    }
+    return true;
+}
+
+static void worker_loop(pipeline_state& st, record_check_fn check) {
+    // 校验函数接收std::string，复用同一个缓冲区避免逐条分配
+    std::string record;
+    for (;;) {
+        pipe_batch* batch;
+        {
+            std::unique_lock<std::mutex> lock(st.mutex);
+            st.work_cv.wait(lock, [&] { return !st.work.empty() || st.closed; });
+            if (st.work.empty()) {
+                return;
+            }
+            batch = st.work.front();
+            st.work.pop_front();
+        }
+        batch->verdicts.resize(batch->records.size());
+        for (size_t i = 0; i < batch->records.size(); i++) {
+            const pipe_record& rec = batch->records[i];
+            if (rec.truncated) {
+                batch->verdicts[i] = 0;
+                continue;
+            }
+            record.assign(batch->data, rec.offset, rec.length);
+            batch->verdicts[i] = check(record) ? 1 : 0;
+        }
+        {
+            std::lock_guard<std::mutex> lock(st.mutex);
+            batch->done = true;
+        }
+        st.done_cv.notify_one();
+    }
+}
+
+// 按提交顺序输出：每次取走队首连续的已完成批次，合并成一次write
+static void writer_loop(pipeline_state& st, int out_fd, uint64_t& valid) {
+    std::vector<batch_ptr> ready;
+    std::string out;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(st.mutex);
+            st.done_cv.wait(lock, [&] {
+                return (!st.inflight.empty() && st.inflight.front()->done) ||
+                       (st.closed && st.inflight.empty());
+            });
+            if (st.inflight.empty()) {
+                return;
+            }
+            while (!st.inflight.empty() && st.inflight.front()->done) {
+                ready.push_back(std::move(st.inflight.front()));
+                st.inflight.pop_front();
+            }
+        }
+        st.space_cv.notify_one();
+
+        out.clear();
+        for (const batch_ptr& b : ready) {
+            for (size_t i = 0; i < b->records.size(); i++) {
+                valid += b->verdicts[i];
+                out += b->verdicts[i] ? '1' : '0';
+                out += '\t';
+                out.append(b->data, b->records[i].offset, b->records[i].length);
+                out += '\n';
+            }
+        }
+        bool ok = write_all(out_fd, out.data(), out.size());
+
+        {
+            std::lock_guard<std::mutex> lock(st.mutex);
+            if (!ok) {
+                st.write_failed = true;
+            }
+            for (batch_ptr& b : ready) {
+                st.free_list.push_back(std::move(b));
+            }
+        }
+        ready.clear();
+        if (!ok) {
+            st.space_cv.notify_one();
+        }
+    }
+}
+
+// 读取端：切分记录、攒批、按数量或延迟提交
+class PipelineReader {
+public:
+    PipelineReader(pipeline_state& st, const pipeline_options& opt, size_t max_inflight)
+        : st_(st), opt_(opt), max_inflight_(max_inflight) {
+        batch_ = acquire();
+    }
+
+    // 读到EOF或出错；返回是否没有读错误
+    bool run(int fd, pipeline_stats& stats) {
+        std::vector<char> buf(opt_.read_size);
+        bool ok = true;
+        for (;;) {
+            // 有未提交的记录时，最多再等到期限，期限内没有新数据就提交
+            if (!batch_->records.empty()) {
+                int wait_ms = remaining_ms();
+                if (wait_ms <= 0 || !wait_readable(fd, wait_ms)) {
+                    if (!submit(stats)) break;
+                    continue;
+                }
+            }
+            ssize_t n = read(fd, buf.data(), buf.size());
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    wait_readable(fd, -1);
+                    continue;
+                }
+                ok = false;
+                break;
+            }
+            if (n == 0) {
+                // 末尾没有换行的最后一行
+                if (!skipping_ && batch_->data.size() > partial_) {
+                    finish_record(stats);
+                }
+                break;
+            }
+            stats.bytes_in += static_cast<uint64_t>(n);
+            consume(buf.data(), static_cast<size_t>(n), stats);
+            if (batch_->records.size() >= opt_.batch_records ||
+                (!batch_->records.empty() && batch_->data.size() >= opt_.read_size)) {
+                if (!submit(stats)) break;
+            }
+        }
+        if (!batch_->records.empty()) {
+            submit(stats);
+        }
+        return ok;
+    }
+
+private:
+    batch_ptr acquire() {
+        batch_ptr b;
+        {
+            std::lock_guard<std::mutex> lock(st_.mutex);
+            if (!st_.free_list.empty()) {
+                b = std::move(st_.free_list.back());
+                st_.free_list.pop_back();
+            }
+        }
+        if (!b) {
+            b.reset(new pipe_batch());
+        }
+        b->data.clear();
+        b->records.clear();
+        b->verdicts.clear();
+        b->done = false;
+        return b;
+    }
+
+    // 把一段输入拆成记录追加到当前批次
+    void consume(const char* p, size_t n, pipeline_stats& stats) {
+        const char* end = p + n;
+        while (p < end) {
+            const char* nl = static_cast<const char*>(memchr(p, '\n', end - p));
+            if (skipping_) {
+                // 超长记录的剩余部分，丢弃到行尾
+                if (nl == nullptr) return;
+                skipping_ = false;
+                p = nl + 1;
+                continue;
+            }
+            size_t take = (nl != nullptr ? nl : end) - p;
+            size_t room = opt_.max_record - (batch_->data.size() - partial_);
+            if (take > room) {
+                batch_->data.append(p, room);
+                stats.overlong++;
+                finish_record(stats, true);
+                skipping_ = (nl == nullptr);
+                p = nl != nullptr ? nl + 1 : end;
+                continue;
+            }
+            batch_->data.append(p, take);
+            if (nl == nullptr) return;
+            finish_record(stats);
+            p = nl + 1;
+        }
+    }
+
+    void finish_record(pipeline_stats& stats, bool truncated = false) {
+        size_t len = batch_->data.size() - partial_;
+        if (len > 0 && batch_->data.back() == '\r') len--;
+        if (batch_->records.empty()) {
+            first_record_ = std::chrono::steady_clock::now();
+        }
+        batch_->records.push_back({static_cast<uint32_t>(partial_), static_cast<uint32_t>(len), truncated});
+        partial_ = batch_->data.size();
+        stats.records++;
+    }
+
+    int remaining_ms() const {
+        auto elapsed = std::chrono::steady_clock::now() - first_record_;
+        long long ms = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+        return static_cast<int>(opt_.max_delay_ms - ms);
+    }
+
+    static bool wait_readable(int fd, int timeout_ms) {
+        struct pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        for (;;) {
+            int r = poll(&pfd, 1, timeout_ms);
+            if (r < 0 && errno == EINTR) continue;
+            return r != 0;      // 出错时也返回true，由read报告
+        }
+    }
+
+    // 提交当前批次，未完成的行尾移到新批次；在途批次满时等待；输出失败时返回false
+    bool submit(pipeline_stats& stats) {
+        batch_ptr next = acquire();
+        next->data.assign(batch_->data, partial_, std::string::npos);
+        batch_->data.resize(partial_);
+        partial_ = 0;
+        stats.batches++;
+
+        bool ok;
+        {
+            std::unique_lock<std::mutex> lock(st_.mutex);
+            st_.space_cv.wait(lock, [&] { return st_.inflight.size() < max_inflight_ || st_.write_failed; });
+            st_.work.push_back(batch_.get());
+            st_.inflight.push_back(std::move(batch_));
+            ok = !st_.write_failed;
+        }
+        st_.work_cv.notify_one();
+        batch_ = std::move(next);
+        return ok;
+    }
+
+    pipeline_state& st_;
+    const pipeline_options& opt_;
+    size_t max_inflight_;
+    batch_ptr batch_;
+    size_t partial_ = 0;                    // 当前未完成记录在batch_->data中的起点
+    bool skipping_ = false;                 // 正在丢弃超长记录的剩余部分
+    std::chrono::steady_clock::time_point first_record_;
+};
+
+bool run_validation_pipeline(int in_fd, int out_fd, const pipeline_options& options,
+                             pipeline_stats* stats) {
+    pipeline_stats local = {0, 0, 0, 0, 0};
+    if (options.check == nullptr || options.read_size == 0 || options.batch_records == 0 ||
+        options.max_record == 0) {
+        return false;
+    }
+    unsigned workers = options.workers;
+    if (workers == 0) {
+        workers = std::thread::hardware_concurrency();
+        if (workers == 0) workers = 1;
+    }
+    size_t max_inflight = options.max_inflight != 0 ? options.max_inflight : workers * 4;
+
+    pipeline_state st;
+    std::vector<std::thread> threads;
+    for (unsigned i = 0; i < workers; i++) {
+        threads.emplace_back(worker_loop, std::ref(st), options.check);
+    }
+    std::thread writer(writer_loop, std::ref(st), out_fd, std::ref(local.valid));
+
+    bool read_ok;
+    {
+        PipelineReader reader(st, options, max_inflight);
+        read_ok = reader.run(in_fd, local);
+    }
+    {
+        std::lock_guard<std::mutex> lock(st.mutex);
+        st.closed = true;
+    }
+    st.work_cv.notify_all();
+    st.done_cv.notify_all();
+    for (std::thread& t : threads) {
+        t.join();
+    }
+    writer.join();
+
+    if (stats != nullptr) {
+        *stats = local;
+    }
+    return read_ok && !st.write_failed;
+}
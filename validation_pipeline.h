@@ -0,0 +1,54 @@
+#ifndef VALIDATION_PIPELINE_H
+#define VALIDATION_PIPELINE_H
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+// 流式校验：从管道/标准输入逐行读取记录（如 tail -F access.log | ...），
+// 多线程校验后按输入顺序输出 "1\t记录\n" 或 "0\t记录\n"。
+//
+// 读取端每次大块read，跨缓冲区的记录拼接后再切分；记录攒成批次交给工作线程，
+// 输出线程按批次序号依次写出。批次在攒够batch_records条或距第一条完整记录
+// 超过max_delay_ms时提交，因此输入稀疏时每条记录的输出延迟有上界；
+// 在途批次达到max_inflight时读取端停止读取，由管道把背压传给上游。
+
+// 单条记录的校验函数，is_valid_host和validate_*系列都可以直接使用
+typedef bool (*record_check_fn)(const std::string& record);
+
+// parse_srt_url的适配：返回0视为通过
+bool check_srt_url_record(const std::string& url);
+
+// 按名字取校验函数："host" "ipv4" "ipv6" "hostname" "netmask" "cidr" "mac"
+// "interface" "filepath" "numeric" "alphanumeric" "srt"；未知名字返回nullptr
+record_check_fn pipeline_check_by_name(std::string_view name);
+
+struct pipeline_options {
+    record_check_fn check;          // 校验函数
+    unsigned workers;               // 工作线程数，0表示CPU核数
+    size_t read_size;               // 单次read的字节数
+    size_t batch_records;           // 每批最多记录数
+    size_t max_record;              // 单条记录最大长度，超出部分丢弃且记录判为0
+    int max_delay_ms;               // 批次从第一条记录到提交的最长等待
+    size_t max_inflight;            // 在途批次上限，0表示workers的4倍
+};
+
+// 默认参数：1MB读取、每批4096条、单条64KB、最长等待5ms
+pipeline_options default_pipeline_options(record_check_fn check);
+
+struct pipeline_stats {
+    uint64_t records;               // 记录数（含空行）
+    uint64_t valid;                 // 通过的记录数
+    uint64_t overlong;              // 被截断的记录数
+    uint64_t batches;               // 提交的批次数
+    uint64_t bytes_in;              // 读取的字节数
+};
+
+// 从in_fd读到EOF，结果写到out_fd；末尾没有换行的最后一行也作为一条记录，行尾的'\r'被去掉
+// 读写出错时返回false（已读入的记录仍会处理完）
+// 写入已关闭的管道会产生SIGPIPE，需要时由调用方忽略该信号
+bool run_validation_pipeline(int in_fd, int out_fd, const pipeline_options& options,
+                             pipeline_stats* stats = nullptr);
+
+#endif // VALIDATION_PIPELINE_H
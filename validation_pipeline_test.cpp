@@ -0,0 +1,167 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <thread>
+#include <chrono>
+#include <unistd.h>
+
+#include "validation_pipeline.h"
+#include "host_validator.h"
+#include "input_validation.h"
+#include "cidr.h"
+
+using namespace std;
+
+static int g_passed = 0;
+static int g_total = 0;
+
+static void check(const string& name, bool ok) {
+    g_total++;
+    cout << "测试: " << name << " ";
+    if (ok) {
+        cout << "✓ 通过" << endl;
+        g_passed++;
+    } else {
+        cout << "✗ 失败" << endl;
+    }
+}
+
+// 用两根管道运行流水线：feed在单独线程中向输入端写数据并负责关闭，输出全部收集到字符串
+struct pipe_run {
+    string output;
+    pipeline_stats stats;
+    bool ok;
+};
+
+template <typename Feed>
+static pipe_run run_pipes(const pipeline_options& opt, Feed feed) {
+    int in[2], out[2];
+    pipe_run r;
+    r.ok = false;
+    if (pipe(in) != 0 || pipe(out) != 0) {
+        return r;
+    }
+    thread feeder([&]() {
+        feed(in[1]);
+        close(in[1]);
+    });
+    thread collector([&]() {
+        char buf[4096];
+        ssize_t n;
+        while ((n = read(out[0], buf, sizeof(buf))) > 0) r.output.append(buf, n);
+    });
+    r.ok = run_validation_pipeline(in[0], out[1], opt, &r.stats);
+    close(out[1]);
+    feeder.join();
+    collector.join();
+    close(in[0]);
+    close(out[0]);
+    return r;
+}
+
+static void write_str(int fd, const string& s) {
+    size_t off = 0;
+    while (off < s.size()) {
+        ssize_t w = write(fd, s.data() + off, s.size() - off);
+        if (w <= 0) return;
+        off += static_cast<size_t>(w);
+    }
+}
+
+static string expected_output(const vector<string>& records, record_check_fn fn) {
+    string out;
+    for (const string& r : records) {
+        out += fn(r) ? "1\t" : "0\t";
+        out += r;
+        out += '\n';
+    }
+    return out;
+}
+
+int main() {
+    cout << "=== 流式校验流水线测试 ===" << endl;
+
+    check("按名字取校验函数", pipeline_check_by_name("host") == is_valid_host &&
+                              pipeline_check_by_name("cidr") == validate_cidr &&
+                              pipeline_check_by_name("srt") == check_srt_url_record &&
+                              pipeline_check_by_name("nope") == nullptr);
+
+    pipeline_options opt = default_pipeline_options(is_valid_host);
+    opt.workers = 2;
+
+    pipe_run r = run_pipes(opt, [](int fd) { write_str(fd, "example.com\nbad_host\r\n\n1.2.3.4"); });
+    check("基本输出", r.ok && r.output == "1\texample.com\n0\tbad_host\n0\t\n1\t1.2.3.4\n");
+    check("统计", r.stats.records == 4 && r.stats.valid == 2 && r.stats.bytes_in == 30);
+
+    // 极小的读缓冲和批次：几乎每条记录都跨越读边界，且分散到大量批次中
+    vector<string> records;
+    mt19937 rng(49);
+    const char alphabet[] = "abcxyz0129-._:";
+    for (int i = 0; i < 20000; i++) {
+        string s;
+        size_t n = rng() % 30;
+        for (size_t j = 0; j < n; j++) s += alphabet[rng() % (sizeof(alphabet) - 1)];
+        records.push_back(s);
+    }
+    string input;
+    for (const string& s : records) input += s + "\n";
+    pipeline_options small = opt;
+    small.workers = 4;
+    small.read_size = 7;
+    small.batch_records = 16;
+    small.max_inflight = 3;
+    r = run_pipes(small, [&](int fd) { write_str(fd, input); });
+    check("跨缓冲区记录且保持顺序", r.ok && r.output == expected_output(records, is_valid_host) &&
+                                    r.stats.batches >= records.size() / 16);
+
+    pipeline_options srt = default_pipeline_options(check_srt_url_record);
+    vector<string> urls = {"srt://1.1.1.1:9000?latency=200", "srt://a;b:9000", "http://x", "srt://:9000?mode=listener"};
+    string url_input;
+    for (const string& u : urls) url_input += u + "\n";
+    r = run_pipes(srt, [&](int fd) { write_str(fd, url_input); });
+    check("SRT URL校验", r.ok && r.output == expected_output(urls, check_srt_url_record));
+
+    pipeline_options capped = opt;
+    capped.max_record = 8;
+    capped.read_size = 5;
+    r = run_pipes(capped, [](int fd) { write_str(fd, "abcdefghijklmnop.com\nok.com\nabcdefghi"); });
+    check("超长记录截断", r.ok && r.output == "0\tabcdefgh\n1\tok.com\n0\tabcdefgh\n" && r.stats.overlong == 2);
+
+    // 延迟上界：输入端保持打开，记录也应在max_delay_ms后很快输出
+    int in[2], out[2];
+    bool piped = pipe(in) == 0 && pipe(out) == 0;
+    pipeline_stats stats;
+    bool run_ok = false;
+    thread runner([&]() { run_ok = run_validation_pipeline(in[0], out[1], opt, &stats); close(out[1]); });
+    auto start = chrono::steady_clock::now();
+    write_str(in[1], "example.com\n");
+    char buf[64];
+    ssize_t n = piped ? read(out[0], buf, sizeof(buf)) : -1;
+    long long waited = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    check("输入未结束时按期限输出", n == 14 && string(buf, n) == "1\texample.com\n" && waited < 1000);
+    close(in[1]);
+    runner.join();
+    close(in[0]);
+    close(out[0]);
+    check("正常结束", run_ok && stats.records == 1);
+
+    // 小批量突发：多次突发被合并成较少的批次，结果完整有序
+    vector<string> burst_records;
+    for (int i = 0; i < 300; i++) burst_records.push_back("host" + to_string(i) + ".example.com");
+    r = run_pipes(opt, [&](int fd) {
+        for (size_t i = 0; i < burst_records.size(); i += 3) {
+            write_str(fd, burst_records[i] + "\n" + burst_records[i + 1] + "\n" + burst_records[i + 2] + "\n");
+            this_thread::sleep_for(chrono::microseconds(500));
+        }
+    });
+    check("小批量突发", r.ok && r.output == expected_output(burst_records, is_valid_host) &&
+                        r.stats.batches < burst_records.size() / 3);
+
+    pipeline_options bad = opt;
+    bad.check = nullptr;
+    check("无效参数", !run_validation_pipeline(0, 1, bad));
+
+    cout << endl << "测试结果: " << g_passed << "/" << g_total << " 通过" << endl;
+    return g_passed == g_total ? 0 : 1;
+}
@@ -0,0 +1,207 @@
+#include "validation_schema.h"
+#include "input_validation.h"
+#include "host_validator.h"
+#include "cidr.h"
+#include "parse_int.h"
+#include <algorithm>
+#include <climits>
+#include <unordered_set>
+
+field_spec make_field(const std::string& name, field_kind kind, bool required) {
+    return make_range_field(name, kind, LLONG_MIN, LLONG_MAX, required);
+}
+
+field_spec make_range_field(const std::string& name, field_kind kind,
+                            long long min_value, long long max_value, bool required) {
+    field_spec spec;
+    spec.name = name;
+    spec.kind = kind;
+    spec.required = required;
+    spec.min_value = min_value;
+    spec.max_value = max_value;
+    return spec;
+}
+
+// 把bool型校验函数适配成校验步骤
+template <bool (*Fn)(const std::string&)>
+static int check_bool(const std::string& value, long long, long long) {
+    return Fn(value) ? 0 : VALIDATION_INVALID;
+}
+
+static int check_string(const std::string& value, long long lo, long long hi) {
+    long long len = static_cast<long long>(value.size());
+    return (len < lo || len > hi) ? VALIDATION_OUT_OF_RANGE : 0;
+}
+
+// 十进制整数（可带负号）；溢出或含非数字字符为无效
+static int check_integer(const std::string& value, long long lo, long long hi) {
+    long long v;
+    switch (parse_int(value, v, lo, hi)) {
+    case PARSE_INT_OK:
+        return 0;
+    case PARSE_INT_OUT_OF_RANGE:
+        return VALIDATION_OUT_OF_RANGE;
+    default:
+        return VALIDATION_INVALID;
+    }
+}
+
+// 端口号：纯数字且在1-65535内
+static int check_port(const std::string& value, long long lo, long long hi) {
+    int port;
+    if (value.empty() || value[0] == '-' || parse_int(value, port) != PARSE_INT_OK ||
+        !validate_port(port)) {
+        return VALIDATION_INVALID;
+    }
+    return (port < lo || port > hi) ? VALIDATION_OUT_OF_RANGE : 0;
+}
+
+// 各校验类型的函数和相对代价（越小越先执行）
+struct kind_entry {
+    int (*check)(const std::string&, long long, long long);
+    int cost;
+};
+
+static kind_entry lookup_kind(field_kind kind) {
+    switch (kind) {
+    case FIELD_STRING:       return {check_string, 0};
+    case FIELD_NUMERIC:      return {check_bool<validate_numeric>, 1};
+    case FIELD_ALPHANUMERIC: return {check_bool<validate_alphanumeric>, 1};
+    case FIELD_INTEGER:      return {check_integer, 1};
+    case FIELD_PORT:         return {check_port, 1};
+    case FIELD_INTERFACE:    return {check_bool<validate_interface_name>, 1};
+    case FIELD_MAC:          return {check_bool<validate_mac_address>, 1};
+    case FIELD_FILEPATH:     return {check_bool<validate_filepath>, 2};
+    case FIELD_HOSTNAME:     return {check_bool<validate_hostname>, 2};
+    case FIELD_IPV4:         return {check_bool<validate_ipv4>, 2};
+    case FIELD_IPV6:         return {check_bool<validate_ipv6>, 2};
+    case FIELD_NETMASK:      return {check_bool<validate_netmask>, 2};
+    case FIELD_CIDR:         return {check_bool<validate_cidr>, 2};
+    case FIELD_HOST:         return {check_bool<is_valid_host>, 3};
+    }
+    return {nullptr, 0};
+}
+
+bool ValidationPlan::compile(const std::vector<field_spec>& schema) {
+    std::unordered_set<std::string> seen;
+    std::vector<step> steps;
+    std::vector<int> costs;
+    steps.reserve(schema.size());
+
+    for (size_t i = 0; i < schema.size(); i++) {
+        const field_spec& spec = schema[i];
+        if (spec.name.empty() || !seen.insert(spec.name).second) {
+            return false;
+        }
+        kind_entry entry = lookup_kind(spec.kind);
+        if (entry.check == nullptr || spec.min_value > spec.max_value) {
+            return false;
+        }
+        steps.push_back({i, entry.check, spec.min_value, spec.max_value, spec.required});
+        // 缺失检查不需要调用校验器，必填字段排在同代价组的最前
+        costs.push_back(entry.cost * 2 + (spec.required ? 0 : 1));
+    }
+
+    std::vector<size_t> order(steps.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::stable_sort(order.begin(), order.end(),
+                     [&costs](size_t a, size_t b) { return costs[a] < costs[b]; });
+
+    fields_ = schema;
+    steps_.clear();
+    for (size_t i : order) {
+        steps_.push_back(steps[i]);
+    }
+    return true;
+}
+
+template <typename Map>
+bool ValidationPlan::validate_map(const Map& record, std::vector<validation_error>* errors,
+                                  size_t record_index, bool stop_at_first) const {
+    bool ok = true;
+    for (const step& st : steps_) {
+        auto it = record.find(fields_[st.field].name);
+        int failure = 0;
+        if (it == record.end()) {
+            failure = st.required ? VALIDATION_MISSING : 0;
+        } else {
+            failure = st.check(it->second, st.lo, st.hi);
+        }
+        if (failure != 0) {
+            ok = false;
+            if (errors) {
+                errors->push_back({record_index, st.field,
+                                   static_cast<validation_failure>(failure)});
+            }
+            if (stop_at_first) {
+                break;
+            }
+        }
+    }
+    return ok;
+}
+
+bool ValidationPlan::validate(const std::map<std::string, std::string>& record,
+                              std::vector<validation_error>* errors,
+                              size_t record_index, bool stop_at_first) const {
+    return validate_map(record, errors, record_index, stop_at_first);
+}
+
+bool ValidationPlan::validate(const std::unordered_map<std::string, std::string>& record,
+                              std::vector<validation_error>* errors,
+                              size_t record_index, bool stop_at_first) const {
+    return validate_map(record, errors, record_index, stop_at_first);
+}
+
+size_t ValidationPlan::validate_batch(const std::vector<std::map<std::string, std::string>>& records,
+                                      std::vector<validation_error>& errors,
+                                      std::vector<uint8_t>* valid,
+                                      bool stop_at_first) const {
+    if (valid) {
+        valid->assign(records.size(), 0);
+    }
+    size_t passed = 0;
+    for (size_t i = 0; i < records.size(); i++) {
+        bool ok = validate_map(records[i], &errors, i, stop_at_first);
+        if (valid) (*valid)[i] = ok ? 1 : 0;
+        passed += ok ? 1 : 0;
+    }
+    return passed;
+}
+
+size_t ValidationPlan::validate_columns(const std::vector<const std::vector<std::string>*>& columns,
+                                        size_t rows, std::vector<validation_error>& errors,
+                                        std::vector<uint8_t>* valid,
+                                        bool stop_at_first) const {
+    if (valid) {
+        valid->assign(rows, 0);
+    }
+    if (columns.size() != fields_.size()) {
+        errors.push_back({VALIDATION_NO_INDEX, VALIDATION_NO_INDEX, VALIDATION_SCHEMA_MISMATCH});
+        return 0;
+    }
+
+    size_t passed = 0;
+    for (size_t row = 0; row < rows; row++) {
+        bool ok = true;
+        for (const step& st : steps_) {
+            const std::vector<std::string>* col = columns[st.field];
+            int failure = 0;
+            if (col == nullptr || row >= col->size() || (*col)[row].empty()) {
+                failure = st.required ? VALIDATION_MISSING : 0;
+            } else {
+                failure = st.check((*col)[row], st.lo, st.hi);
+            }
+            if (failure != 0) {
+                ok = false;
+                errors.push_back({row, st.field, static_cast<validation_failure>(failure)});
+                if (stop_at_first) {
+                    break;
+                }
+            }
+        }
+        if (valid) (*valid)[row] = ok ? 1 : 0;
+        passed += ok ? 1 : 0;
+    }
+    return passed;
+}
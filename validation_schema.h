@@ -0,0 +1,119 @@
+#ifndef VALIDATION_SCHEMA_H
+#define VALIDATION_SCHEMA_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+
+// 声明式校验：把 字段→校验器/范围/是否必填 的描述编译成扁平的校验计划，
+// 然后对大量记录（map批量或列存数组）一次性执行，并汇总所有失败。
+
+// 字段校验类型，对应input_validation.h / host_validator.h中的校验函数
+enum field_kind {
+    FIELD_STRING,           // 任意字符串，仅按[min, max]检查长度
+    FIELD_IPV4,             // validate_ipv4
+    FIELD_IPV6,             // validate_ipv6
+    FIELD_HOST,             // is_valid_host (IPv4/IPv6/域名)
+    FIELD_HOSTNAME,         // validate_hostname
+    FIELD_NETMASK,          // validate_netmask
+    FIELD_CIDR,             // validate_cidr
+    FIELD_MAC,              // validate_mac_address
+    FIELD_INTERFACE,        // validate_interface_name
+    FIELD_FILEPATH,         // validate_filepath
+    FIELD_NUMERIC,          // validate_numeric
+    FIELD_ALPHANUMERIC,     // validate_alphanumeric
+    FIELD_PORT,             // 十进制端口号，validate_port
+    FIELD_INTEGER,          // 十进制整数（可带负号），按[min, max]检查数值
+};
+
+// 字段描述
+struct field_spec {
+    std::string name;       // 字段名
+    field_kind kind;        // 校验类型
+    bool required;          // 是否必填；非必填字段缺失时不校验
+    long long min_value;    // FIELD_INTEGER为数值下限，FIELD_STRING为长度下限
+    long long max_value;    // FIELD_INTEGER为数值上限，FIELD_STRING为长度上限
+};
+
+// 便捷构造：min/max使用类型的全范围
+field_spec make_field(const std::string& name, field_kind kind, bool required = true);
+field_spec make_range_field(const std::string& name, field_kind kind,
+                            long long min_value, long long max_value, bool required = true);
+
+// 失败原因
+enum validation_failure {
+    VALIDATION_MISSING = 1,     // 必填字段缺失
+    VALIDATION_INVALID,         // 格式错误
+    VALIDATION_OUT_OF_RANGE,    // 格式正确但超出范围
+    VALIDATION_SCHEMA_MISMATCH, // 输入与计划不匹配（整批无法校验），record和field均为VALIDATION_NO_INDEX
+};
+
+// 不对应具体记录或字段的失败项使用的下标
+const size_t VALIDATION_NO_INDEX = static_cast<size_t>(-1);
+
+// 一条失败记录
+struct validation_error {
+    size_t record;              // 记录下标
+    size_t field;               // 字段在schema中的下标
+    validation_failure reason;
+};
+
+// 编译后的校验计划
+class ValidationPlan {
+public:
+    ValidationPlan() = default;
+
+    // 编译schema：字段名为空或重复时返回false
+    // 执行顺序按校验代价从低到高排列，使失败记录尽早短路
+    bool compile(const std::vector<field_spec>& schema);
+
+    const std::vector<field_spec>& fields() const { return fields_; }
+
+    // 校验单条记录；errors非空时追加失败项（record为record_index）
+    // stop_at_first为true时遇到第一个失败即返回
+    bool validate(const std::map<std::string, std::string>& record,
+                  std::vector<validation_error>* errors = nullptr,
+                  size_t record_index = 0, bool stop_at_first = true) const;
+    bool validate(const std::unordered_map<std::string, std::string>& record,
+                  std::vector<validation_error>* errors = nullptr,
+                  size_t record_index = 0, bool stop_at_first = true) const;
+
+    // 批量校验记录；valid非空时valid[i]为1/0，返回通过的记录数
+    size_t validate_batch(const std::vector<std::map<std::string, std::string>>& records,
+                          std::vector<validation_error>& errors,
+                          std::vector<uint8_t>* valid = nullptr,
+                          bool stop_at_first = true) const;
+
+    // 列存批量校验：columns[i]对应fields()[i]，所有非空列长度相同，均为rows
+    // columns[i]为nullptr表示该字段整列缺失；单元格为空字符串视为缺失
+    // columns.size()与fields().size()不同时不校验任何行，追加一条VALIDATION_SCHEMA_MISMATCH并返回0
+    size_t validate_columns(const std::vector<const std::vector<std::string>*>& columns,
+                            size_t rows, std::vector<validation_error>& errors,
+                            std::vector<uint8_t>* valid = nullptr,
+                            bool stop_at_first = true) const;
+
+private:
+    // 返回0表示通过，否则为validation_failure
+    typedef int (*check_fn)(const std::string& value, long long lo, long long hi);
+
+    // 扁平化的校验步骤
+    struct step {
+        size_t field;
+        check_fn check;
+        long long lo;
+        long long hi;
+        bool required;
+    };
+
+    template <typename Map>
+    bool validate_map(const Map& record, std::vector<validation_error>* errors,
+                      size_t record_index, bool stop_at_first) const;
+
+    std::vector<field_spec> fields_;
+    std::vector<step> steps_;
+};
+
+#endif // VALIDATION_SCHEMA_H